@@ -468,11 +468,18 @@ namespace quda {
       static constexpr bool block_float_ghost = !fixed && ghost_fixed;
 
     public:
+      /** Whether sites carry their own norm, in which case writes must go through save() */
+      static constexpr bool site_norm = block_float && fixed;
+
       /**
        * Constructor for the FieldOrderCB class
        * @param field The field that we are accessing
+       * @param nFace Depth of the ghost zone
+       * @param v_ Optional pointer overriding the field data
+       * @param ghost_ Optional pointers overriding the ghost buffers
+       * @param norm_ Optional pointer overriding the per-site norms (block-float only)
        */
-    FieldOrderCB(const ColorSpinorField &field, int nFace=1, void *v_=0, void **ghost_=0)
+    FieldOrderCB(const ColorSpinorField &field, int nFace=1, void *v_=0, void **ghost_=0, void *norm_=0)
       : v(v_? static_cast<complex<storeFloat>*>(const_cast<void*>(v_))
 	  : static_cast<complex<storeFloat>*>(const_cast<void*>(field.V()))),
         accessor(field), scale(static_cast<Float>(1.0)), scale_inv(static_cast<Float>(1.0))
@@ -494,8 +501,8 @@ namespace quda {
 #endif
 
         if (block_float) {
-          // only if we have block_float format do we set these (only block_orthogonalize.cu at present)
-          norm = static_cast<float*>(const_cast<void*>(field.Norm()));
+          // only if we have block_float format do we set these (block_orthogonalize.cu and host fixed-point fields)
+          norm = static_cast<float*>(norm_ ? norm_ : const_cast<void*>(field.Norm()));
           norm_offset = field.NormBytes()/(2*sizeof(float));
         }
       }
@@ -577,6 +584,61 @@ namespace quda {
       __device__ __host__ inline fieldorder_wrapper<Float,storeFloat> operator()(int parity, int x_cb, int s, int c, int n=0)
   { return fieldorder_wrapper<Float,storeFloat>(v, accessor.index(parity,x_cb,s,c,n), scale, scale_inv); }
 
+      /**
+       * Read all nSpin*nColor*nVec elements of a site into registers.
+       * Unlike the element accessors, this also works for the
+       * block-float format.
+       * @param out Array the site is unpacked into, ordered (s,c,n)
+       * @param parity Field parity
+       * @param x_cb Checkerboard site index
+       */
+      template <typename T>
+      __device__ __host__ inline void load(complex<T> out[nSpin*nColor*nVec], int parity, int x_cb) const
+      {
+        for (int s=0; s<nSpin; s++)
+          for (int c=0; c<nColor; c++)
+            for (int n=0; n<nVec; n++) {
+              const complex<Float> a = (*this)(parity, x_cb, s, c, n);
+              out[(s*nColor+c)*nVec+n] = complex<T>(a.real(), a.imag());
+            }
+      }
+
+      /**
+       * Write all nSpin*nColor*nVec elements of a site.  With the
+       * block-float format the site maximum becomes the per-site norm
+       * and the elements are stored relative to it, so this (and not
+       * the writable element accessor) must be used to write such
+       * fields.
+       * @param in Array holding the site, ordered (s,c,n)
+       * @param parity Field parity
+       * @param x_cb Checkerboard site index
+       */
+      template <typename T>
+      __device__ __host__ inline void save(const complex<T> in[nSpin*nColor*nVec], int parity, int x_cb)
+      {
+        if (site_norm) {
+          Float max_ = static_cast<Float>(0.0);
+          for (int i=0; i<nSpin*nColor*nVec; i++) {
+            max_ = fmax(max_, static_cast<Float>(fabs(in[i].real())));
+            max_ = fmax(max_, static_cast<Float>(fabs(in[i].imag())));
+          }
+          // the stored norm is the factor applied on read, i.e., max / storeFloat max
+          norm[parity*norm_offset+x_cb] = max_ / std::numeric_limits<storeFloat>::max();
+          const Float scale_ = max_ > static_cast<Float>(0.0) ? std::numeric_limits<storeFloat>::max() / max_ : static_cast<Float>(0.0);
+          for (int s=0; s<nSpin; s++)
+            for (int c=0; c<nColor; c++)
+              for (int n=0; n<nVec; n++) {
+                const complex<Float> a(in[(s*nColor+c)*nVec+n].real(), in[(s*nColor+c)*nVec+n].imag());
+                v[accessor.index(parity,x_cb,s,c,n)] = complex<storeFloat>(round(scale_ * a.real()), round(scale_ * a.imag()));
+              }
+        } else {
+          for (int s=0; s<nSpin; s++)
+            for (int c=0; c<nColor; c++)
+              for (int n=0; n<nVec; n++)
+                (*this)(parity, x_cb, s, c, n) = in[(s*nColor+c)*nVec+n];
+        }
+      }
+
 #ifndef DISABLE_GHOST
       /**
        * Read-only complex-member accessor function for the ghost
@@ -1126,9 +1188,14 @@ namespace quda {
   int faceVolumeCB[4];
   int stride;
   int nParity;
-      SpaceSpinorColorOrder(const ColorSpinorField &a, int nFace=1, Float *field_=0, float *dummy=0, Float **ghost_=0)
+  // fixed-point (host half and quarter) fields are stored in block-float format
+  static constexpr bool block_float = isFixed<Float>::value;
+  float *norm;
+  size_t norm_offset;
+      SpaceSpinorColorOrder(const ColorSpinorField &a, int nFace=1, Float *field_=0, float *norm_=0, Float **ghost_=0)
       : field(field_ ? field_ : (Float*)a.V()), offset(a.Bytes()/(2*sizeof(Float))),
-    volumeCB(a.VolumeCB()), stride(a.Stride()), nParity(a.SiteSubset())
+    volumeCB(a.VolumeCB()), stride(a.Stride()), nParity(a.SiteSubset()),
+    norm(norm_ ? norm_ : (float*)a.Norm()), norm_offset(a.NormBytes()/(2*sizeof(float)))
   {
     if (volumeCB != stride) errorQuda("Stride must equal volume for this field order");
     for (int i=0; i<4; i++) {
@@ -1160,9 +1227,23 @@ namespace quda {
       }
     }
 #endif
+    if (block_float) {
+      const RegType nrm = norm[parity*norm_offset + x];
+      for (int i=0; i<length; i++) v[i] *= nrm;
+    }
   }
 
-  __device__ __host__ inline void save(const RegType v[length], int x, int parity=0) {
+  __device__ __host__ inline void save(const RegType v_in[length], int x, int parity=0) {
+    RegType v[length];
+    for (int i=0; i<length; i++) v[i] = v_in[i];
+    if (block_float) {
+      // the stored norm is the factor applied on read, i.e., max / Float max
+      RegType max_ = static_cast<RegType>(0.0);
+      for (int i=0; i<length; i++) max_ = fmax(max_, fabs(v[i]));
+      norm[parity*norm_offset + x] = max_ / std::numeric_limits<Float>::max();
+      const RegType scale = max_ > static_cast<RegType>(0.0) ? std::numeric_limits<Float>::max() / max_ : static_cast<RegType>(0.0);
+      for (int i=0; i<length; i++) v[i] = round(scale * v[i]);
+    }
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
     typedef S<Float,length> structure;
     trove::coalesced_ptr<structure> field_((structure*)field);
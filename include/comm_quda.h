@@ -154,6 +154,16 @@ extern "C" {
    */
   void comm_gather_gpuid(int *gpuid_recv_buf);
 
+  /**
+     @brief Gather a fixed-size buffer from all processes onto process 0
+     @param[in] send_buf Local buffer of length nbytes
+     @param[out] recv_buf Buffer of length nbytes*comm_size() that will
+     be filled with the buffers of all processes (in rank order).  Only
+     referenced on process 0.
+     @param[in] nbytes Size in bytes of each process's buffer
+   */
+  void comm_gather(void *send_buf, void *recv_buf, size_t nbytes);
+
   /**
      Enabled peer-to-peer communication.
      @param hostname_buf Array that holds all process hostnames
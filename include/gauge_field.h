@@ -230,6 +230,15 @@ namespace quda {
     virtual void exchangeGhost(QudaLinkDirection = QUDA_LINK_BACKWARDS) = 0;
     virtual void injectGhost(QudaLinkDirection = QUDA_LINK_BACKWARDS) = 0;
 
+    /**
+       @brief Populate the border / halo region of an extended gauge
+       field, regardless of its location
+       @param R The thickness of the extended region in each dimension
+       @param no_comms_fill Do local exchange to fill out the extended
+       region in non-partitioned dimensions
+    */
+    virtual void exchangeExtendedGhost(const int *R, bool no_comms_fill=false) = 0;
+
     int Length() const { return length; }
     int Ncolor() const { return nColor; }
     QudaReconstructType Reconstruct() const { return reconstruct; }
@@ -55,6 +55,55 @@ namespace quda {
 			const GaugeField& dataOr,
 			double rho, double epsilon);
 
+  /**
+     Apply nSteps steps of APE smearing to an extended gauge
+     field in place.  Before each step the field is copied into the
+     workspace and the halo of the workspace is exchanged, so a single
+     workspace serves any number of steps.  Host and device fields are
+     both supported; the halo of U itself is not updated.
+
+     @param U Extended gauge field to be smeared
+     @param tmp Workspace of the same type and geometry as U
+     @param nSteps Number of smearing steps
+     @param alpha smearing parameter
+     @param no_comms_fill Whether to fill the halo of the workspace in
+     dimensions that are not partitioned
+  */
+  void APEnStep (GaugeField &U, GaugeField &tmp, unsigned int nSteps, double alpha, bool no_comms_fill=false);
+
+  /**
+     Apply nSteps steps of STOUT smearing to an extended gauge
+     field in place.  Before each step the field is copied into the
+     workspace and the halo of the workspace is exchanged, so a single
+     workspace serves any number of steps.  Host and device fields are
+     both supported; the halo of U itself is not updated.
+
+     @param U Extended gauge field to be smeared
+     @param tmp Workspace of the same type and geometry as U
+     @param nSteps Number of smearing steps
+     @param rho smearing parameter
+     @param no_comms_fill Whether to fill the halo of the workspace in
+     dimensions that are not partitioned
+  */
+  void STOUTnStep (GaugeField &U, GaugeField &tmp, unsigned int nSteps, double rho, bool no_comms_fill=false);
+
+  /**
+     Apply nSteps steps of Over Improved STOUT smearing to an
+     extended gauge field in place.  Before each step the field is copied into the
+     workspace and the halo of the workspace is exchanged, so a single
+     workspace serves any number of steps.  Host and device fields are
+     both supported; the halo of U itself is not updated.
+
+     @param U Extended gauge field to be smeared
+     @param tmp Workspace of the same type and geometry as U
+     @param nSteps Number of smearing steps
+     @param rho smearing parameter
+     @param epsilon smearing parameter
+     @param no_comms_fill Whether to fill the halo of the workspace in
+     dimensions that are not partitioned
+  */
+  void OvrImpSTOUTnStep (GaugeField &U, GaugeField &tmp, unsigned int nSteps, double rho, double epsilon, bool no_comms_fill=false);
+
 
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
@@ -100,7 +149,8 @@ namespace quda {
                        const double tolerance,
 		       const int stopWtheta);
   /**
-     Compute the Fmunu tensor
+     Compute the Fmunu tensor.  On the host, the gauge field may be in
+     QDP or MILC order, with Fmunu in MILC order.
      @param Fmunu The Fmunu tensor
      @param gauge The gauge field upon which to compute the Fmnu tensor
      @param location The location of where to do the computation
@@ -112,8 +162,17 @@ namespace quda {
   /**
      Compute the topological charge
      @param Fmunu The Fmunu tensor, usually calculated from a smeared configuration
-     @param location The location of where to do the computation, currently supports only the GPU
+     @param location The location of where to do the computation, which must match that of Fmunu
    */
 
   double computeQCharge(GaugeField& Fmunu, QudaFieldLocation location);
+
+  /**
+     Compute the topological charge, together with its density summed
+     over each timeslice, on a host field
+     @param q_t Output charge of each global timeslice (length comm_dim(3)*X[3])
+     @param Fmunu The Fmunu tensor, usually calculated from a smeared configuration
+     @return The total charge
+   */
+  double computeQChargeTimeslice(double *q_t, GaugeField& Fmunu);
 }
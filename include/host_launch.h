@@ -0,0 +1,271 @@
+#pragma once
+
+/**
+   @file host_launch.h
+
+   @section Description
+
+   Launcher for the host (CPU field) variants of the kernels.  The
+   host variants are written as a loop body over a flattened index
+   (typically x_cb + parity * volumeCB) which is handed to
+   launchHost() (or launchHostReduce() for reductions), rather than
+   each kernel hand-rolling its own loop nest.  The loop is run on the
+   OpenMP backend with either a static schedule (one contiguous block
+   of iterations per thread) or a dynamic schedule with a given chunk
+   size.  The thread count and chunk size are stored in TuneParam::aux
+   and are autotuned through tuneLaunch() exactly as the launch
+   parameters of the device kernels are, under a key derived from the
+   key of the calling Tunable.
+ */
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <tune_quda.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace quda {
+
+  /**
+     Number of iterations each partial sum of launchHostReduce() covers.
+     The partial sums are fixed by the iteration count alone, so that
+     reductions are deterministic regardless of the thread count and
+     schedule chosen by the autotuner.
+   */
+  constexpr int host_reduce_block = 1024;
+
+  /**
+     @return The maximum number of threads a host launch may use
+   */
+  inline int hostMaxThreads()
+  {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  /**
+     @brief Run f(i) for i in [0, n) on the host
+     @param[in] n Number of iterations
+     @param[in] f Loop body
+     @param[in] threads Number of threads to use
+     @param[in] chunk Chunk size of a dynamic schedule, or 0 for a
+     static schedule
+   */
+  template <typename F> inline void hostFor(int n, F &f, int threads, int chunk)
+  {
+    if (chunk > 0) {
+#pragma omp parallel for schedule(dynamic, chunk) num_threads(threads)
+      for (int i = 0; i < n; i++) f(i);
+    } else {
+#pragma omp parallel for schedule(static) num_threads(threads)
+      for (int i = 0; i < n; i++) f(i);
+    }
+  }
+
+  /**
+     @brief Reduce f(i) for i in [0, n) on the host.  Iterations are
+     summed into partials of host_reduce_block iterations in parallel,
+     which are then combined in order on the calling thread.
+     @param[in] n Number of iterations
+     @param[in] identity Identity element of the reduction
+     @param[in] f Loop body, returning the value of iteration i
+     @param[in] r Binary reduction operator
+     @param[in] threads Number of threads to use
+     @param[in] chunk Chunk size (in iterations) of a dynamic schedule,
+     or 0 for a static schedule
+     @return The reduced value
+   */
+  template <typename T, typename F, typename R>
+  inline T hostReduce(int n, const T &identity, F &f, R &r, int threads, int chunk)
+  {
+    const int n_block = (n + host_reduce_block - 1) / host_reduce_block;
+    std::vector<T> partial(n_block, identity);
+
+    auto block = [&](int b) {
+      T sum = identity;
+      const int end = std::min(n, (b + 1) * host_reduce_block);
+      for (int i = b * host_reduce_block; i < end; i++) sum = r(sum, f(i));
+      partial[b] = sum;
+    };
+    hostFor(n_block, block, threads, chunk > 0 ? std::max(1, chunk / host_reduce_block) : 0);
+
+    T result = identity;
+    for (int b = 0; b < n_block; b++) result = r(result, partial[b]);
+    return result;
+  }
+
+  /**
+     The Tunable used to autotune a host launch.  It takes its key from
+     the calling Tunable (or from an explicit key for host routines
+     that are not Tunables), with ",host" and the OpenMP thread count
+     appended to the aux string, and forwards the performance metrics
+     and pre/post tuning hooks to it.  The launch is tuned over aux.x
+     = number of threads and aux.y = chunk size, where aux.y = 0
+     denotes a static schedule.
+   */
+  template <typename Launch> class HostLaunch : public Tunable {
+    Tunable *owner;
+    const TuneKey key;
+    Launch &launch;
+    const int n;
+    const int min_chunk;
+
+    long long flops() const { return owner ? owner->flops() : 0; }
+    long long bytes() const { return owner ? owner->bytes() : 0; }
+    unsigned int sharedBytesPerThread() const { return 0; }
+    unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+
+  public:
+    HostLaunch(Tunable &owner, Launch &launch, int n, int min_chunk) :
+      owner(&owner), key(owner.tuneKey()), launch(launch), n(n), min_chunk(min_chunk)
+    {
+      writeAuxString("%s,host%s", key.aux, getOmpThreadStr());
+    }
+
+    HostLaunch(const TuneKey &key, Launch &launch, int n, int min_chunk) :
+      owner(nullptr), key(key), launch(launch), n(n), min_chunk(min_chunk)
+    {
+      writeAuxString("%s,host%s", key.aux, getOmpThreadStr());
+    }
+
+    virtual ~HostLaunch() { }
+
+    void apply(const cudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (traceEnabled() >= 2) {
+        auto start = std::chrono::steady_clock::now();
+        launch(tp.aux.x, tp.aux.y);
+        postLaunchTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      } else {
+        launch(tp.aux.x, tp.aux.y);
+      }
+    }
+
+    TuneKey tuneKey() const { return TuneKey(key.volume, key.name, aux); }
+
+    void preTune() { if (owner) owner->preTune(); }
+    void postTune() { if (owner) owner->postTune(); }
+    int tuningIter() const { return owner ? owner->tuningIter() : 1; }
+
+    void initTuneParam(TuneParam &param) const
+    {
+      param.block = dim3(1, 1, 1);
+      param.grid = dim3(1, 1, 1);
+      param.shared_bytes = 0;
+      param.aux = make_int4(1, 0, 1, 1);
+    }
+
+    /** sets default values for when tuning is disabled */
+    void defaultTuneParam(TuneParam &param) const
+    {
+      initTuneParam(param);
+      param.aux.x = hostMaxThreads();
+    }
+
+    /**
+       For each thread count (doubling up to the maximum) we try the
+       static schedule followed by dynamic schedules with chunk sizes
+       increasing by powers of four, for as long as every thread
+       receives at least one chunk.
+     */
+    bool advanceTuneParam(TuneParam &param) const
+    {
+      const int chunk = param.aux.y == 0 ? min_chunk : 4 * param.aux.y;
+      if (param.aux.x > 1 && (long)chunk * param.aux.x < n) {
+        param.aux.y = chunk;
+        return true;
+      }
+      param.aux.y = 0;
+
+      if (param.aux.x < hostMaxThreads()) {
+        param.aux.x = std::min(2 * param.aux.x, hostMaxThreads());
+        return true;
+      }
+      param.aux.x = 1;
+      return false;
+    }
+
+    std::string paramString(const TuneParam &param) const
+    {
+      std::stringstream ps;
+      ps << "threads=" << param.aux.x << ", ";
+      if (param.aux.y > 0) ps << "dynamic chunk=" << param.aux.y;
+      else ps << "static";
+      return ps.str();
+    }
+  };
+
+  /**
+     @brief Run f(i) for i in [0, n) on the host, with the thread count
+     and schedule autotuned under the key of the calling Tunable
+     @param[in] tunable The Tunable whose host variant is being launched
+     @param[in] n Number of iterations
+     @param[in] f Loop body
+   */
+  template <typename F> void launchHost(Tunable &tunable, int n, F f)
+  {
+    auto launch = [&](int threads, int chunk) { hostFor(n, f, threads, chunk); };
+    HostLaunch<decltype(launch)> host(tunable, launch, n, 64);
+    host.apply(0);
+  }
+
+  /**
+     @brief As above, for host routines that are not Tunables
+     @param[in] key Key to tune the launch under
+     @param[in] n Number of iterations
+     @param[in] f Loop body
+   */
+  template <typename F> void launchHost(const TuneKey &key, int n, F f)
+  {
+    auto launch = [&](int threads, int chunk) { hostFor(n, f, threads, chunk); };
+    HostLaunch<decltype(launch)> host(key, launch, n, 64);
+    host.apply(0);
+  }
+
+  /**
+     @brief Reduce f(i) for i in [0, n) on the host, with the thread
+     count and schedule autotuned under the key of the calling
+     Tunable.  The result does not depend on the tuned parameters.
+     @param[in] tunable The Tunable whose host variant is being launched
+     @param[in] n Number of iterations
+     @param[in] identity Identity element of the reduction
+     @param[in] f Loop body, returning the value of iteration i
+     @param[in] r Binary reduction operator
+     @return The reduced value
+   */
+  template <typename T, typename F, typename R> T launchHostReduce(Tunable &tunable, int n, const T &identity, F f, R r)
+  {
+    T result = identity;
+    auto launch = [&](int threads, int chunk) { result = hostReduce(n, identity, f, r, threads, chunk); };
+    HostLaunch<decltype(launch)> host(tunable, launch, n, host_reduce_block);
+    host.apply(0);
+    return result;
+  }
+
+  /**
+     @brief As above, for host routines that are not Tunables
+     @param[in] key Key to tune the launch under
+     @param[in] n Number of iterations
+     @param[in] identity Identity element of the reduction
+     @param[in] f Loop body, returning the value of iteration i
+     @param[in] r Binary reduction operator
+     @return The reduced value
+   */
+  template <typename T, typename F, typename R> T launchHostReduce(const TuneKey &key, int n, const T &identity, F f, R r)
+  {
+    T result = identity;
+    auto launch = [&](int threads, int chunk) { result = hostReduce(n, identity, f, r, threads, chunk); };
+    HostLaunch<decltype(launch)> host(key, launch, n, host_reduce_block);
+    host.apply(0);
+    return result;
+  }
+
+} // namespace quda
@@ -7,9 +7,57 @@
 #include <color_spinor_field.h>
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <string>
+#include <cstring>
 
 namespace quda {
 
+  /**
+     SolverHistory records the convergence history of a solve: the
+     iterated residual at each reported iteration, the true residual
+     at each reliable update, and the time elapsed so far.  Only a SolverParam constructed from a
+     QudaInvertParam that requests the history records; the copies
+     made for inner solvers, smoothers and preconditioners do not.
+   */
+  class SolverHistory {
+    bool enabled;
+    std::string solver;                          /** name of the solver that recorded the history */
+    std::vector<QudaSolverHistoryEntry> entries;
+    size_t n_written;                            /** entries already returned to the QudaInvertParam */
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    SolverHistory() : enabled(false), n_written(0) { }
+
+    SolverHistory(const QudaInvertParam &param) :
+      enabled(param.history != nullptr || strlen(param.history_file) > 0),
+      n_written(0),
+      start(std::chrono::steady_clock::now())
+    {
+    }
+
+    bool Enabled() const { return enabled; }
+
+    /**
+       @brief Add an entry to the history (no-op if not enabled)
+       @param[in] name Name of the solver recording the entry
+       @param[in] k Iteration count
+       @param[in] r2 L2 norm squared of the iterated residual
+       @param[in] b2 L2 norm squared of the source vector
+       @param[in] hq2 Heavy quark residual
+       @param[in] true_r2 L2 norm squared of the true residual (negative if not computed)
+     */
+    void record(const char *name, int k, double r2, double b2, double hq2, double true_r2 = -1.0);
+
+    /**
+       @brief Append the entries recorded since the last update to the
+       history array of the QudaInvertParam and to the history file
+       @param[in,out] param The QudaInvertParam to be updated
+     */
+    void update(QudaInvertParam &param);
+  };
+
   /**
      SolverParam is the meta data used to define linear solvers.
    */
@@ -220,6 +268,9 @@ namespace quda {
     /** Which external lib to use in the solver */
     QudaExtLibType extlib_type;
 
+    /** Convergence history of the solve (only recorded by the outer solver) */
+    SolverHistory history;
+
     /**
        Default constructor
      */
@@ -256,7 +307,8 @@ namespace quda {
       eigcg_max_restarts(param.eigcg_max_restarts), max_restart_num(param.max_restart_num),
       inc_tol(param.inc_tol), eigenval_tol(param.eigenval_tol),
       verbosity_precondition(param.verbosity_precondition),
-      is_preconditioner(false), global_reduction(true), mg_instance(false), extlib_type(param.extlib_type)
+      is_preconditioner(false), global_reduction(true), mg_instance(false), extlib_type(param.extlib_type),
+      history(param)
     {
       for (int i=0; i<num_offset; i++) {
 	offset[i] = param.offset[i];
@@ -317,6 +369,7 @@ namespace quda {
        @param param the QudaInvertParam to be updated
      */
     void updateInvertParam(QudaInvertParam &param, int offset=-1) {
+      history.update(param);
       param.true_res = true_res;
       param.true_res_hq = true_res_hq;
       param.iter += iter;
@@ -411,8 +464,23 @@ namespace quda {
        @param[in] k iteration count
        @param[in] r2 L2 norm squared of the residual
        @param[in] hq2 Heavy quark residual
+       @param[in] record Whether to record the iteration in the convergence history
+     */
+    void PrintStats(const char *name, int k, double r2, double b2, double hq2, bool record = true);
+
+    /**
+       @brief Record the true residual, computed at a reliable update,
+       in the convergence history (if enabled)
+       @param[in] name Name of solver that called this
+       @param[in] k iteration count
+       @param[in] r2 L2 norm squared of the true residual
+       @param[in] b2 L2 norm squared of the source vector
+       @param[in] hq2 Heavy quark residual
      */
-    void PrintStats(const char *name, int k, double r2, double b2, double hq2);
+    void RecordTrueResidual(const char *name, int k, double r2, double b2, double hq2)
+    {
+      param.history.record(name, k, r2, b2, hq2, r2);
+    }
 
     /**
        @brief Prints out the summary of the solver convergence
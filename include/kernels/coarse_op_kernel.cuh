@@ -968,21 +968,93 @@ namespace quda {
 
   }
 
+  /**
+     @brief Owner-computes variant of computeVUV used on the CPU.
+     Rather than scattering each fine-grid contribution into the
+     coarse fields, the coarse site (parity_coarse, x_coarse_cb)
+     gathers the contributions from every fine site in its aggregate
+     (using the coarse_to_fine map), sums them locally and then
+     updates Y and X once.  Since each coarse site is owned by a
+     single thread no atomics are required, and the summation order
+     is fixed by the aggregate ordering so the result is independent
+     of the number of threads.
+   */
+  template<bool from_coarse, typename Float, int dim, QudaDirection dir,
+           int fineSpin, int fineColor, int coarseSpin, int coarseColor, typename Arg, typename Gamma>
+  inline void computeVUVAggregate(Arg &arg, const Gamma &gamma, int parity_coarse, int x_coarse_cb, int c_row, int c_col) {
+
+    const int x_coarse = parity_coarse*arg.coarseVolumeCB + x_coarse_cb;
+    const int geoBlockSizeCB = arg.fineVolumeCB / arg.coarseVolumeCB / 2;
+
+    complex<Float> Y[coarseSpin*coarseSpin];
+    complex<Float> X[coarseSpin*coarseSpin];
+    for (int i=0; i<coarseSpin*coarseSpin; i++) { Y[i] = 0.0; X[i] = 0.0; }
+
+    for (int parity=0; parity<2; parity++) {
+      for (int b=0; b<geoBlockSizeCB; b++) {
+        const int x_cb = arg.coarse_to_fine[(x_coarse*2 + parity)*geoBlockSizeCB + b] - parity*arg.fineVolumeCB;
+
+        int coord[QUDA_MAX_DIM];
+        getCoords(coord, x_cb, arg.x_size, parity);
+
+        //Check to see if we are on the edge of a block.  If adjacent site
+        //is in same block, M = X, else M = Y
+        const bool isDiagonal = ((coord[dim]+1)%arg.x_size[dim])/arg.geo_bs[dim] == coord[dim]/arg.geo_bs[dim] ? true : false;
+
+        complex<Float> vuv[coarseSpin*coarseSpin];
+        multiplyVUV<from_coarse,Float,dim,dir,fineSpin,fineColor,coarseSpin,coarseColor,Arg>(vuv, arg, gamma, parity, x_cb, c_row, c_col);
+
+        complex<Float> *M = isDiagonal ? X : Y;
+        for (int s2=0; s2<coarseSpin*coarseSpin; s2++) M[s2] += vuv[s2];
+      }
+    }
+
+    const int dim_index = arg.dim_index % arg.Y_atomic.geometry;
+
+    for (int s_row = 0; s_row < coarseSpin; s_row++) { // Chiral row block
+      for (int s_col = 0; s_col < coarseSpin; s_col++) { // Chiral column block
+        arg.Y_atomic(dim_index,parity_coarse,x_coarse_cb,s_row,s_col,c_row,c_col) += Y[s_row*coarseSpin+s_col];
+      }
+    }
+
+    for (int s2=0; s2<coarseSpin*coarseSpin; s2++) X[s2] *= -arg.kappa;
+
+    for (int s_row = 0; s_row < coarseSpin; s_row++) { // Chiral row block
+      for (int s_col = 0; s_col < coarseSpin; s_col++) { // Chiral column block
+        if (dir == QUDA_BACKWARDS) {
+          arg.X_atomic(0,parity_coarse,x_coarse_cb,s_col,s_row,c_col,c_row) += conj(X[s_row*coarseSpin+s_col]);
+        } else {
+          arg.X_atomic(0,parity_coarse,x_coarse_cb,s_row,s_col,c_row,c_col) += X[s_row*coarseSpin+s_col];
+        }
+      }
+    }
+
+    if (!arg.bidirectional) {
+      for (int s_row = 0; s_row < coarseSpin; s_row++) { // Chiral row block
+        for (int s_col = 0; s_col < coarseSpin; s_col++) { // Chiral column block
+          const Float sign = (s_row == s_col) ? static_cast<Float>(1.0) : static_cast<Float>(-1.0);
+          arg.X_atomic(0,parity_coarse,x_coarse_cb,s_row,s_col,c_row,c_col) += sign*X[s_row*coarseSpin+s_col];
+        }
+      }
+    }
+
+  }
+
   template<bool from_coarse, typename Float, int dim, QudaDirection dir, int fineSpin, int fineColor, int coarseSpin, int coarseColor, typename Arg>
   void ComputeVUVCPU(Arg arg) {
 
     Gamma<Float, QUDA_DEGRAND_ROSSI_GAMMA_BASIS, dim> gamma;
-    constexpr bool shared_atomic = false; // not supported on CPU
-    constexpr bool parity_flip = true;
 
-    for (int parity=0; parity<2; parity++) {
+    // each thread owns whole coarse sites (all colors) since the
+    // backwards X contribution is stored transposed in color
 #pragma omp parallel for
-      for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) { // Loop over fine volume
-	for (int c_row=0; c_row<coarseColor; c_row++)
-	  for (int c_col=0; c_col<coarseColor; c_col++)
-	    computeVUV<shared_atomic,parity_flip,from_coarse,Float,dim,dir,fineSpin,fineColor,coarseSpin,coarseColor>(arg, gamma, parity, x_cb, c_row, c_col, 0, 0);
-      } // c/b volume
-    } // parity
+    for (int x_coarse=0; x_coarse<2*arg.coarseVolumeCB; x_coarse++) { // Loop over coarse volume
+      const int parity_coarse = x_coarse >= arg.coarseVolumeCB ? 1 : 0;
+      const int x_coarse_cb = x_coarse - parity_coarse*arg.coarseVolumeCB;
+      for (int c_row=0; c_row<coarseColor; c_row++)
+        for (int c_col=0; c_col<coarseColor; c_col++)
+          computeVUVAggregate<from_coarse,Float,dim,dir,fineSpin,fineColor,coarseSpin,coarseColor>(arg, gamma, parity_coarse, x_coarse_cb, c_row, c_col);
+    } // coarse volume
   }
 
   // compute indices for shared-atomic kernel
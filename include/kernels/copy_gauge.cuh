@@ -25,33 +25,26 @@ namespace quda {
   };
 
   /**
-     Generic CPU gauge reordering and packing
+     Generic CPU gauge reordering and packing of a single link, which
+     is run over all links by the host launcher
   */
   template <typename FloatOut, typename FloatIn, int length, typename Arg>
-  void copyGauge(Arg &arg) {
+  void copyGauge(Arg &arg, int x, int d, int parity) {
     typedef typename mapper<FloatIn>::type RegTypeIn;
     typedef typename mapper<FloatOut>::type RegTypeOut;
 
-    for (int parity=0; parity<2; parity++) {
-
-      for (int d=0; d<arg.geometry; d++) {
-	for (int x=0; x<arg.volume/2; x++) {
 #ifdef FINE_GRAINED_ACCESS
-	  for (int i=0; i<Ncolor(length); i++)
-	    for (int j=0; j<Ncolor(length); j++) {
-	      arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
-	    }
+    for (int i=0; i<Ncolor(length); i++)
+      for (int j=0; j<Ncolor(length); j++) {
+	arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
+      }
 #else
-	  RegTypeIn in[length];
-	  RegTypeOut out[length];
-	  arg.in.load(in, x, d, parity);
-	  for (int i=0; i<length; i++) out[i] = in[i];
-	  arg.out.save(out, x, d, parity);
+    RegTypeIn in[length];
+    RegTypeOut out[length];
+    arg.in.load(in, x, d, parity);
+    for (int i=0; i<length; i++) out[i] = in[i];
+    arg.out.save(out, x, d, parity);
 #endif
-	}
-      }
-
-    }
   }
 
   /**
@@ -118,32 +111,25 @@ namespace quda {
   }
 
   /**
-     Generic CPU gauge ghost reordering and packing
+     Generic CPU gauge ghost reordering and packing of a single ghost
+     link, which is run over all ghost links by the host launcher
   */
   template <typename FloatOut, typename FloatIn, int length, typename Arg>
-  void copyGhost(Arg &arg) {
+  void copyGhost(Arg &arg, int x, int d, int parity) {
     typedef typename mapper<FloatIn>::type RegTypeIn;
     typedef typename mapper<FloatOut>::type RegTypeOut;
 
-    for (int parity=0; parity<2; parity++) {
-
-      for (int d=0; d<arg.nDim; d++) {
-        for (int x=0; x<arg.faceVolumeCB[d]; x++) {
 #ifdef FINE_GRAINED_ACCESS
-          for (int i=0; i<Ncolor(length); i++)
-            for (int j=0; j<Ncolor(length); j++)
-              arg.out.Ghost(d+arg.out_offset, parity, x, i, j) = arg.in.Ghost(d+arg.in_offset, parity, x, i, j);
+    for (int i=0; i<Ncolor(length); i++)
+      for (int j=0; j<Ncolor(length); j++)
+        arg.out.Ghost(d+arg.out_offset, parity, x, i, j) = arg.in.Ghost(d+arg.in_offset, parity, x, i, j);
 #else
-          RegTypeIn in[length];
-          RegTypeOut out[length];
-          arg.in.loadGhost(in, x, d+arg.in_offset, parity); // assumes we are loading
-          for (int i=0; i<length; i++) out[i] = in[i];
-          arg.out.saveGhost(out, x, d+arg.out_offset, parity);
+    RegTypeIn in[length];
+    RegTypeOut out[length];
+    arg.in.loadGhost(in, x, d+arg.in_offset, parity); // assumes we are loading
+    for (int i=0; i<length; i++) out[i] = in[i];
+    arg.out.saveGhost(out, x, d+arg.out_offset, parity);
 #endif
-        }
-      }
-
-    }
   }
 
   /**
@@ -2,6 +2,9 @@
 #include <color_spinor_field_order.h>
 #include <index_helper.cuh>
 #include <cub_helper.cuh> // for vector_type
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #if (__COMPUTE_CAPABILITY__ >= 300 || __CUDA_ARCH__ >= 300)
 #include <generics/shfl.h>
 #endif
@@ -19,9 +22,15 @@ namespace quda {
     DSLASH_FULL
   };
 
-  template <typename Float, typename yFloat, typename ghostFloat, int coarseSpin, int coarseColor, QudaFieldOrder csOrder, QudaGaugeFieldOrder gOrder>
+  /**
+     @tparam csFloat Storage type of the color-spinor fields; a
+     fixed-point type here selects the block-float format of host
+     half and quarter precision fields
+   */
+  template <typename Float, typename yFloat, typename ghostFloat, int coarseSpin, int coarseColor, QudaFieldOrder csOrder, QudaGaugeFieldOrder gOrder,
+            typename csFloat=Float>
   struct DslashCoarseArg {
-    typedef typename colorspinor::FieldOrderCB<Float,coarseSpin,coarseColor,1,csOrder,Float,ghostFloat> F;
+    typedef typename colorspinor::FieldOrderCB<Float,coarseSpin,coarseColor,1,csOrder,csFloat,ghostFloat,false,isFixed<csFloat>::value> F;
     typedef typename gauge::FieldOrder<Float,coarseColor*coarseSpin,coarseSpin,gOrder,true,yFloat> G;
     typedef typename gauge::FieldOrder<Float,coarseColor*coarseSpin,coarseSpin,gOrder,true,yFloat> GY;
 
@@ -370,9 +379,18 @@ namespace quda {
 
   }
 
-  // CPU kernel for applying the coarse Dslash to a vector
+  /**
+     CPU kernel for applying the coarse Dslash to a vector.  We thread
+     over the combined (parity, source, x_cb) index: each iteration
+     owns the output site it writes to, and the ghost zones have been
+     filled prior to the kernel and are only read, so no
+     synchronization is required.
+
+     @param arg Kernel argument struct
+     @param nThreads Number of OpenMP threads to use (<=0 means use the default)
+  */
   template <typename Float, int nDim, int Ns, int Nc, int Mc, bool dslash, bool clover, bool dagger, DslashType type, typename Arg>
-  void coarseDslash(Arg arg)
+  void coarseDslash(Arg arg, int nThreads)
   {
     // the fine-grain parameters mean nothing for CPU variant
     const int color_stride = 1;
@@ -381,21 +399,178 @@ namespace quda {
     const int dir = 0;
     const int dim = 0;
 
-    for (int parity= 0; parity < arg.nParity; parity++) {
+    const int volumeCB = arg.volumeCB;
+    const int nSrc = arg.dim[4];
+    const int length = arg.nParity * nSrc * volumeCB;
+
+#ifdef _OPENMP
+    if (nThreads <= 0) nThreads = omp_get_max_threads();
+#endif
+
+#pragma omp parallel for schedule(static) num_threads(nThreads)
+    for (int i = 0; i < length; i++) {
+      const int x_cb = i % volumeCB; // 4-d volume
+      const int src_idx = (i / volumeCB) % nSrc;
       // for full fields then set parity from loop else use arg setting
-      parity = (arg.nParity == 2) ? parity : arg.parity;
-
-      for (int src_idx = 0; src_idx < arg.dim[4]; src_idx++) {
-	//#pragma omp parallel for
-	for(int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
-	  for (int s=0; s<2; s++) {
-	    for (int color_block=0; color_block<Nc; color_block+=Mc) { // Mc=Nc means all colors in a thread
-	      coarseDslash<Float,nDim,Ns,Nc,Mc,color_stride,dim_thread_split,dslash,clover,dagger,type,dir,dim>(arg, x_cb, src_idx, parity, s, color_block, color_offset);
+      const int parity = (arg.nParity == 2) ? i / (nSrc * volumeCB) : arg.parity;
+
+      for (int s=0; s<2; s++) {
+	for (int color_block=0; color_block<Nc; color_block+=Mc) { // Mc=Nc means all colors in a thread
+	  coarseDslash<Float,nDim,Ns,Nc,Mc,color_stride,dim_thread_split,dslash,clover,dagger,type,dir,dim>(arg, x_cb, src_idx, parity, s, color_block, color_offset);
+	}
+      }
+    }
+
+  }
+
+  /**
+     Applies the coarse operator at a given parity and checkerboard
+     site index to a block of up to Msrc sources.  Each link matrix
+     element is loaded once and applied to every source in the block,
+     so the site update is a small (Ns*Nc) x (Ns*Nc) x Msrc matrix
+     product rather than Msrc separate matrix-vector products.
+
+     @param arg Kernel argument struct
+     @param x_cb The checkerboarded site index
+     @param src_begin The first source in the block
+     @param n_src The number of sources in the block (<= Msrc)
+     @param parity The site parity
+   */
+  template <typename Float, int nDim, int Ns, int Nc, int Msrc, bool dslash, bool clover, bool dagger, DslashType type, typename Arg>
+  inline void coarseDslashSrcBlock(Arg &arg, int x_cb, int src_begin, int n_src, int parity)
+  {
+    constexpr int N = Ns*Nc;
+    const int their_spinor_parity = (arg.nParity == 2) ? 1-parity : 0;
+    const int my_spinor_parity = (arg.nParity == 2) ? parity : 0;
+
+    complex<Float> out[Msrc][N];
+    complex<Float> in[Msrc][N];
+    for (int k=0; k<Msrc; k++)
+      for (int i=0; i<N; i++) out[k][i] = 0.0;
+
+    int coord[5];
+    getCoordsCB(coord, x_cb, arg.dim, arg.X0h, parity);
+    coord[4] = 0;
+
+    if (dslash) {
+      for (int d=0; d<nDim; d++) { // loop over dimension
+
+	//Forward gather - compute fwd offset for spinor fetch
+	const bool fwd_ghost = arg.commDim[d] && (coord[d] + arg.nFace >= arg.dim[d]);
+	if (fwd_ghost ? doHalo<type>() : doBulk<type>()) {
+	  const int fwd_idx = linkIndexP1(coord, arg.dim, d);
+	  for (int k=0; k<n_src; k++) {
+	    const int src_idx = src_begin + k;
+	    coord[4] = src_idx;
+	    const int ghost_idx = fwd_ghost ? ghostFaceIndex<1>(coord, arg.dim, d, arg.nFace) : 0;
+	    for (int s_col=0; s_col<Ns; s_col++)
+	      for (int c_col=0; c_col<Nc; c_col++)
+		in[k][s_col*Nc+c_col] = fwd_ghost ?
+		  arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col) :
+		  arg.inA(their_spinor_parity, fwd_idx + src_idx*arg.volumeCB, s_col, c_col);
+	  }
+	  coord[4] = 0;
+
+	  for (int row=0; row<N; row++) {
+	    for (int col=0; col<N; col++) {
+	      const complex<Float> Y = !dagger ? arg.Y(d+4, parity, x_cb, row, col) : arg.Y(d, parity, x_cb, row, col);
+	      for (int k=0; k<n_src; k++) out[k][row] += Y * in[k][col];
 	    }
 	  }
-	} // 4-d volumeCB
-      } // src index
-    } // parity
+	}
+
+	//Backward gather - compute back offset for spinor and gauge fetch
+	const bool back_ghost = arg.commDim[d] && (coord[d] - arg.nFace < 0);
+	if (back_ghost ? doHalo<type>() : doBulk<type>()) {
+	  const int back_idx = linkIndexM1(coord, arg.dim, d);
+	  // the link ghost is independent of the source index
+	  const int link_ghost_idx = back_ghost ? ghostFaceIndex<0>(coord, arg.dim, d, arg.nFace) : 0;
+	  for (int k=0; k<n_src; k++) {
+	    const int src_idx = src_begin + k;
+	    coord[4] = src_idx;
+	    const int ghost_idx = back_ghost ? ghostFaceIndex<0>(coord, arg.dim, d, arg.nFace) : 0;
+	    for (int s_col=0; s_col<Ns; s_col++)
+	      for (int c_col=0; c_col<Nc; c_col++)
+		in[k][s_col*Nc+c_col] = back_ghost ?
+		  arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col) :
+		  arg.inA(their_spinor_parity, back_idx + src_idx*arg.volumeCB, s_col, c_col);
+	  }
+	  coord[4] = 0;
+
+	  for (int row=0; row<N; row++) {
+	    for (int col=0; col<N; col++) {
+	      const complex<Float> Y = back_ghost ?
+		conj(arg.Y.Ghost(!dagger ? d : d+4, 1-parity, link_ghost_idx, col, row)) :
+		conj(arg.Y(!dagger ? d : d+4, 1-parity, back_idx, col, row));
+	      for (int k=0; k<n_src; k++) out[k][row] += Y * in[k][col];
+	    }
+	  }
+	}
+
+      } // nDim
+
+      for (int k=0; k<n_src; k++)
+	for (int i=0; i<N; i++) out[k][i] *= -arg.kappa;
+    }
+
+    if (doBulk<type>() && clover) {
+      for (int k=0; k<n_src; k++)
+	for (int s_col=0; s_col<Ns; s_col++)
+	  for (int c_col=0; c_col<Nc; c_col++)
+	    in[k][s_col*Nc+c_col] = arg.inB(my_spinor_parity, x_cb+(src_begin+k)*arg.volumeCB, s_col, c_col);
+
+      for (int row=0; row<N; row++) {
+	for (int col=0; col<N; col++) {
+	  //Factor of kappa and diagonal addition now incorporated in X
+	  const complex<Float> X = !dagger ? arg.X(0, parity, x_cb, row, col) : conj(arg.X(0, parity, x_cb, col, row));
+	  for (int k=0; k<n_src; k++) out[k][row] += X * in[k][col];
+	}
+      }
+    }
+
+    // store whole sites so that block-float outputs can set their norm
+    for (int k=0; k<n_src; k++) {
+      const int out_idx = x_cb+(src_begin+k)*arg.volumeCB;
+      // if not halo we just store, else we accumulate
+      if (!doBulk<type>()) {
+	arg.out.load(in[k], my_spinor_parity, out_idx);
+	for (int i=0; i<N; i++) out[k][i] += in[k][i];
+      }
+      arg.out.save(out[k], my_spinor_parity, out_idx);
+    }
+
+  }
+
+  /**
+     Multi-source CPU kernel for applying the coarse Dslash.  We
+     thread over the (parity, x_cb) index and sweep over the sources
+     in blocks of Msrc, so the coarse links at each site are streamed
+     from memory once rather than once per source.
+
+     @param arg Kernel argument struct
+     @param nThreads Number of OpenMP threads to use (<=0 means use the default)
+  */
+  template <typename Float, int nDim, int Ns, int Nc, int Msrc, bool dslash, bool clover, bool dagger, DslashType type, typename Arg>
+  void coarseDslashMultiSrc(Arg arg, int nThreads)
+  {
+    const int volumeCB = arg.volumeCB;
+    const int nSrc = arg.dim[4];
+    const int length = arg.nParity * volumeCB;
+
+#ifdef _OPENMP
+    if (nThreads <= 0) nThreads = omp_get_max_threads();
+#endif
+
+#pragma omp parallel for schedule(static) num_threads(nThreads)
+    for (int i = 0; i < length; i++) {
+      const int x_cb = i % volumeCB; // 4-d volume
+      // for full fields then set parity from loop else use arg setting
+      const int parity = (arg.nParity == 2) ? i / volumeCB : arg.parity;
+
+      for (int src=0; src<nSrc; src+=Msrc) {
+	coarseDslashSrcBlock<Float,nDim,Ns,Nc,Msrc,dslash,clover,dagger,type>(arg, x_cb, src, std::min(Msrc, nSrc-src), parity);
+      }
+    }
 
   }
 
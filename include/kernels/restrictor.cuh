@@ -86,39 +86,52 @@ namespace quda {
 
   }
 
+  /**
+     CPU variant of the restrictor.  As with the GPU kernel, this
+     gathers each coarse site from its aggregate using the
+     coarse_to_fine look up table, rather than scattering from every
+     fine site, so each thread owns whole coarse sites and neither
+     atomics nor a separate zeroing pass are needed.
+  */
   template <typename Float, int fineSpin, int fineColor, int coarseSpin, int coarseColor, int coarse_colors_per_thread, typename Arg>
   void Restrict(Arg arg) {
-    for (int parity_coarse=0; parity_coarse<2; parity_coarse++) 
-      for (int x_coarse_cb=0; x_coarse_cb<arg.out.VolumeCB(); x_coarse_cb++)
-	for (int s=0; s<coarseSpin; s++) 
-	  for (int c=0; c<coarseColor; c++)
-	    arg.out(parity_coarse, x_coarse_cb, s, c) = 0.0;
-
-    // loop over fine degrees of freedom
-    for (int parity=0; parity<arg.nParity; parity++) {
-      parity = (arg.nParity == 2) ? parity : arg.parity;
-
-      for (int x_cb=0; x_cb<arg.in.VolumeCB(); x_cb++) {
-
-	int x = parity*arg.in.VolumeCB() + x_cb;
-	int x_coarse = arg.fine_to_coarse[x];
-	int parity_coarse = (x_coarse >= arg.out.VolumeCB()) ? 1 : 0;
-	int x_coarse_cb = x_coarse - parity_coarse*arg.out.VolumeCB();
-	
-	for (int coarse_color_block=0; coarse_color_block<coarseColor; coarse_color_block+=coarse_colors_per_thread) {
-	  complex<Float> tmp[fineSpin*coarse_colors_per_thread];
-	  rotateCoarseColor<Float,fineSpin,fineColor,coarseColor,coarse_colors_per_thread>
-	    (tmp, arg.in, arg.V, parity, arg.nParity, x_cb, coarse_color_block);
-
-	  for (int s=0; s<fineSpin; s++) {
-	    for (int coarse_color_local=0; coarse_color_local<coarse_colors_per_thread; coarse_color_local++) {
-	      int c = coarse_color_block + coarse_color_local;
-	      arg.out(parity_coarse,x_coarse_cb,arg.spin_map(s,parity),c) += tmp[s*coarse_colors_per_thread+coarse_color_local];
+    // number of fine grid points per parity in each aggregate
+    const int geoBlockSizeCB = arg.in.VolumeCB() / (2*arg.out.VolumeCB());
+
+#pragma omp parallel for
+    for (int x_coarse=0; x_coarse<2*arg.out.VolumeCB(); x_coarse++) {
+      int parity_coarse = (x_coarse >= arg.out.VolumeCB()) ? 1 : 0;
+      int x_coarse_cb = x_coarse - parity_coarse*arg.out.VolumeCB();
+
+      complex<Float> reduced[coarseSpin*coarseColor];
+      for (int i=0; i<coarseSpin*coarseColor; i++) reduced[i] = 0.0;
+
+      // loop over the fine degrees of freedom of this aggregate
+      for (int parity=0; parity<arg.nParity; parity++) {
+	parity = (arg.nParity == 2) ? parity : arg.parity;
+
+	for (int b=0; b<geoBlockSizeCB; b++) {
+	  int x_fine = arg.coarse_to_fine[ (x_coarse*2 + parity) * geoBlockSizeCB + b];
+	  int x_fine_cb = x_fine - parity*arg.in.VolumeCB();
+
+	  for (int coarse_color_block=0; coarse_color_block<coarseColor; coarse_color_block+=coarse_colors_per_thread) {
+	    complex<Float> tmp[fineSpin*coarse_colors_per_thread];
+	    rotateCoarseColor<Float,fineSpin,fineColor,coarseColor,coarse_colors_per_thread>
+	      (tmp, arg.in, arg.V, parity, arg.nParity, x_fine_cb, coarse_color_block);
+
+	    for (int s=0; s<fineSpin; s++) {
+	      for (int coarse_color_local=0; coarse_color_local<coarse_colors_per_thread; coarse_color_local++) {
+		int c = coarse_color_block + coarse_color_local;
+		reduced[arg.spin_map(s,parity)*coarseColor + c] += tmp[s*coarse_colors_per_thread+coarse_color_local];
+	      }
 	    }
 	  }
-
 	}
       }
+
+      for (int s=0; s<coarseSpin; s++)
+	for (int c=0; c<coarseColor; c++)
+	  arg.out(parity_coarse, x_coarse_cb, s, c) = reduced[s*coarseColor + c];
     }
 
   }
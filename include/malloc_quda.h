@@ -9,6 +9,15 @@ namespace quda {
   void printPeakMemUsage();
   void assertAllMemFree();
 
+  /**
+     @brief Print the per-call-site allocation profile, flagging call
+     sites that repeatedly allocate and free short-lived buffers and
+     those with memory still allocated, and write the full profile to
+     QUDA_RESOURCE_PATH/malloc_profile_<rank>.tsv.  Does nothing unless
+     QUDA_ENABLE_MALLOC_PROFILE=1.
+   */
+  void printMallocProfile();
+
   /**
      @return peak device memory allocated
    */
@@ -109,6 +118,12 @@ namespace quda {
     */
     void flush_pinned();
 
+    /**
+       @brief Print the pool statistics (hit rate, bytes reserved,
+       in use and cached, and fragmentation)
+    */
+    void print_stats();
+
   } // namespace pool
 
 }
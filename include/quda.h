@@ -84,6 +84,20 @@ extern "C" {
   } QudaGaugeParam;
 
 
+  /**
+   * A single entry in the convergence history of a linear solve.
+   * An entry is recorded at every iteration the solver reports, at
+   * every reliable update and at convergence.
+   */
+  typedef struct QudaSolverHistoryEntry_s {
+    int iter;                    /**< Iteration count of the entry */
+    double residual;             /**< Iterated L2 relative residual |r|/|b| */
+    double true_residual;        /**< True L2 relative residual |b - Ax|/|b| (negative if not computed at this entry) */
+    double heavy_quark_residual; /**< Heavy-quark residual (zero if not computed) */
+    double secs;                 /**< Time in seconds since the start of the solve */
+  } QudaSolverHistoryEntry;
+
+
   /**
    * Parameters relating to the solver and the choice of Dirac operator.
    */
@@ -340,6 +354,22 @@ extern "C" {
     /** Which external library to use in the linear solvers (MAGMA or Eigen) */
     QudaExtLibType extlib_type;
 
+    /** Caller-allocated array of history_max_length entries in which
+        the convergence history of the outer solver is returned, or
+        NULL to not return it */
+    QudaSolverHistoryEntry *history;
+
+    /** Capacity of the history array */
+    int history_max_length;
+
+    /** Number of entries returned in the history array (set by
+        QUDA; entries beyond history_max_length are dropped) */
+    int history_length;
+
+    /** If non-empty, rank 0 appends the convergence history of each
+        solve to this file */
+    char history_file[256];
+
   } QudaInvertParam;
 
 
@@ -17,12 +17,16 @@ namespace quda {
     double Last(QudaProfileType idx);
     void PrintGlobal();
     bool isRunning(QudaProfileType idx);
+    static bool TraceEnabled();
+    static void WriteTrace(int rank);
   };
 }
 
 #else
 
 #include <sys/time.h>
+#include <chrono>
+#include <string>
 
 #ifdef INTERFACE_NVTX
 #include "nvToolsExt.h"
@@ -30,6 +34,9 @@ namespace quda {
 
 namespace quda {
 
+  /**< Monotonic clock used for all host-side timing */
+  using timer_clock = std::chrono::steady_clock;
+
   /**
    * Use this for recording a fine-grained profile of a QUDA
    * algorithm.  This uses host-side measurement, so should be used
@@ -43,10 +50,10 @@ namespace quda {
     double last;
 
     /**< Used to store when the timer was last started */
-    timeval start;
+    timer_clock::time_point start;
 
     /**< Used to store when the timer was last stopped */
-    timeval stop;
+    timer_clock::time_point stop;
 
     /**< Are we currently timing? */
     bool running;
@@ -61,7 +68,7 @@ namespace quda {
 	printfQuda("ERROR: Cannot start an already running timer (%s:%d in %s())\n", file, line, func);
 	errorQuda("Aborting");
       }
-      gettimeofday(&start, NULL);
+      start = timer_clock::now();
       running = true;
     }
 
@@ -70,11 +77,9 @@ namespace quda {
 	printfQuda("ERROR: Cannot stop an unstarted timer (%s:%d in %s())\n", file, line, func);
 	errorQuda("Aborting");
       }
-      gettimeofday(&stop, NULL);
+      stop = timer_clock::now();
 
-      long ds = stop.tv_sec - start.tv_sec;
-      long dus = stop.tv_usec - start.tv_usec;
-      last = ds + 0.000001*dus;
+      last = std::chrono::duration<double>(stop - start).count();
       time += last;
       count++;
 
@@ -205,6 +210,19 @@ namespace quda {
       global_total_level[idx]++;
     }
 
+    /**
+       @brief Record a complete event in the trace buffer, attributed
+       to the calling host thread.  Safe to call concurrently.
+       @param[in] name Name of the event
+       @param[in] cat Category of the event (the profile name)
+       @param[in] start Time the region was entered
+       @param[in] stop Time the region was left
+    */
+    static void TraceRecord(const std::string &name, const std::string &cat, timer_clock::time_point start,
+                            timer_clock::time_point stop);
+
+    friend class TraceScope;
+
   public:
     TimeProfile(std::string fname) : fname(fname), switchOff(false), use_global(true) { ; }
 
@@ -229,10 +247,13 @@ namespace quda {
     void Stop_(const char *func, const char *file, int line, QudaProfileType idx) {
       profile[idx].Stop(func, file, line); 
       POP_RANGE
+      bool trace = TraceEnabled();
+      if (trace) TraceRecord(fname + ": " + pname[idx], fname, profile[idx].start, profile[idx].stop);
 
       // switch off total timer if we need to
       if (switchOff && idx != QUDA_PROFILE_TOTAL) {
         profile[QUDA_PROFILE_TOTAL].Stop(func,file,line);
+        if (trace) TraceRecord(fname, fname, profile[QUDA_PROFILE_TOTAL].start, profile[QUDA_PROFILE_TOTAL].stop);
         switchOff = false;
       }
       if (use_global) StopGlobal(func,file,line,idx);
@@ -251,6 +272,63 @@ namespace quda {
 
     bool isRunning(QudaProfileType idx) { return profile[idx].running; }
 
+    /**
+       @brief Whether trace recording is enabled.  Tracing is switched
+       on by setting the environment variable QUDA_PROFILE_TRACE to
+       the file prefix the trace should be written to.
+    */
+    static bool TraceEnabled();
+
+    /**
+       @brief Write the recorded trace of this process to
+       <prefix>.<rank>.json in the Chrome / Perfetto trace-event
+       format.  Every profiled region is written as a complete event
+       on the track of the host thread that recorded it, so that the
+       nesting of solver, multigrid level, smoother and operator scopes
+       can be read off the timeline.  No-op if tracing
+       is disabled.
+       @param[in] rank The rank of this process (used as the pid)
+    */
+    static void WriteTrace(int rank);
+  };
+
+  /**
+     @brief RAII helper that adds a named scope to the trace, for
+     regions that are not covered by a TimeProfile, e.g., the stages
+     of a multigrid cycle.  The event name is only formatted when
+     tracing is enabled, so a disabled scope costs a single branch.
+  */
+  class TraceScope {
+    const bool enabled;
+    std::string name;
+    std::string cat;
+    timer_clock::time_point start;
+
+  public:
+    /**
+       @param[in] name Name of the scope
+       @param[in] cat Category of the scope
+       @param[in] index If non-negative, the category is suffixed
+       with this index (e.g., the multigrid level) and the name is
+       prefixed with the resulting category
+    */
+    TraceScope(const char *name, const char *cat = "scope", int index = -1) : enabled(TimeProfile::TraceEnabled())
+    {
+      if (enabled) {
+        this->cat = cat;
+        if (index >= 0) this->cat += " " + std::to_string(index);
+        this->name = index >= 0 ? this->cat + ": " + name : std::string(name);
+        start = timer_clock::now();
+      }
+    }
+
+    ~TraceScope()
+    {
+      if (enabled) TimeProfile::TraceRecord(name, cat, start, timer_clock::now());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
   };
 
 } // namespace quda
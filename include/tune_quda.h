@@ -2,6 +2,7 @@
 #define _TUNE_QUDA_H
 
 #include <string>
+#include <map>
 #include <iostream>
 #include <iomanip>
 #include <cstring>
@@ -55,7 +56,13 @@ namespace quda {
   };
 
 
+  class Tunable;
+  TuneParam &tuneLaunch(Tunable &tunable, QudaTune enabled, QudaVerbosity verbosity);
+  template <typename Launch> class HostLaunch;
+
   class Tunable {
+    friend TuneParam &tuneLaunch(Tunable &tunable, QudaTune enabled, QudaVerbosity verbosity);
+    template <typename Launch> friend class HostLaunch; // forwards flops() and bytes() of the kernel it launches
 
   protected:
     virtual long long flops() const = 0;
@@ -471,7 +478,7 @@ namespace quda {
   };
 
   /**
-     @brief query if tuning is in progress
+     @brief query if tuning is in progress on the calling thread
      @return tuning in progress?
   */
   bool activeTuning();
@@ -479,6 +486,29 @@ namespace quda {
   void loadTuneCache();
   void saveTuneCache(bool error = false);
 
+  /**
+   * @brief Convert a binary tunecache file to the human-readable TSV format
+   * @param[in] bin_path Path to the binary tunecache to read
+   * @param[in] tsv_path Path to the TSV tunecache to write
+   */
+  void exportTuneCache(const std::string &bin_path, const std::string &tsv_path);
+
+  /**
+   * @brief Convert a TSV tunecache file to the binary format
+   * @param[in] tsv_path Path to the TSV tunecache to read
+   * @param[in] bin_path Path to the binary tunecache to write
+   */
+  void importTuneCache(const std::string &tsv_path, const std::string &bin_path);
+
+  /**
+   * @brief Read a tunecache file in either the binary or the TSV
+   * format without touching the live cache.  Entries are read
+   * regardless of the QUDA version or build they were tuned with.
+   * @param[in] path Path to the tunecache to read
+   * @param[out] cache Map the entries are added to
+   */
+  void readTuneCache(const std::string &path, std::map<TuneKey, TuneParam> &cache);
+
   /**
    * @brief Save profile to disk.
    */
@@ -496,6 +526,19 @@ namespace quda {
    */
   void postTrace_(const char *func, const char *file, int line);
 
+  /**
+   * @return The trace level set with QUDA_ENABLE_TRACE (0 = off, 1 =
+   * posted events, 2 = also every kernel launch)
+   */
+  int traceEnabled();
+
+  /**
+   * @brief Report the duration of the launch most recently traced by
+   * this thread, for launches timed on the host
+   * @param[in] time Duration of the launch in seconds
+   */
+  void postLaunchTime(double time);
+
 } // namespace quda
 
 #define postTrace() quda::postTrace_(__func__, quda::file_name(__FILE__), __LINE__)
@@ -181,41 +181,56 @@ void blasCuda(const double2 &a, const double2 &b, const double2 &c,
 
 
 /**
-   Generic blas kernel with four loads and up to four stores.
+   Generic blas kernel with four loads and up to four stores.  On the
+   host we thread over the combined (parity, x_cb) site index, and
+   since the spin and color extents are compile-time constants the
+   inner loops can be vectorized by the compiler when the fields are
+   stored contiguously in SPACE_SPIN_COLOR order.  Sites are loaded
+   and stored whole so that block-float (half and quarter precision)
+   host fields can recompute their per-site norm on the store.
   */
-template <typename Float, int writeX, int writeY, int writeZ, int writeW, int writeV,
+template <typename Float, int nSpin, int nColor, int writeX, int writeY, int writeZ, int writeW, int writeV,
           typename SpinorX, typename SpinorY, typename SpinorZ,
           typename SpinorW, typename SpinorV, typename Functor>
 void genericBlas(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, SpinorV &V, Functor f) {
 
-  for (int parity=0; parity<X.Nparity(); parity++) {
-    for (int x=0; x<X.VolumeCB(); x++) {
-      for (int s=0; s<X.Nspin(); s++) {
-	for (int c=0; c<X.Ncolor(); c++) {
-	  complex<Float> X_(X(parity, x, s, c));
-	  complex<Float> Y_ = Y(parity, x, s, c);
-	  complex<Float> Z_ = Z(parity, x, s, c);
-	  complex<Float> W_ = W(parity, x, s, c);
-	  complex<Float> V_ = V(parity, x, s, c);
-	  f(X_, Y_, Z_, W_, V_);
-	  if (writeX) X(parity, x, s, c) = X_;
-	  if (writeY) Y(parity, x, s, c) = Y_;
-	  if (writeZ) Z(parity, x, s, c) = Z_;
-	  if (writeW) W(parity, x, s, c) = W_;
-	  if (writeV) V(parity, x, s, c) = V_;
-	}
-      }
-    }
+  constexpr int N = nSpin*nColor;
+  const int volumeCB = X.VolumeCB();
+  const int length = X.Nparity() * volumeCB;
+
+#pragma omp parallel for schedule(static) firstprivate(f)
+  for (int i=0; i<length; i++) {
+    const int parity = i / volumeCB;
+    const int x = i - parity * volumeCB;
+    complex<Float> X_[N], Y_[N], Z_[N], W_[N], V_[N];
+    X.load(X_, parity, x);
+    Y.load(Y_, parity, x);
+    Z.load(Z_, parity, x);
+    W.load(W_, parity, x);
+    V.load(V_, parity, x);
+    for (int j=0; j<N; j++) f(X_[j], Y_[j], Z_[j], W_[j], V_[j]);
+    if (writeX) X.save(X_, parity, x);
+    if (writeY) Y.save(Y_, parity, x);
+    if (writeZ) Z.save(Z_, parity, x);
+    if (writeW) W.save(W_, parity, x);
+    if (writeV) V.save(V_, parity, x);
   }
 }
 
+/**
+   Fields are accessed through the register types of the storage
+   types Float and yFloat; fixed-point host fields use the
+   block-float format with a norm per site.
+ */
 template <typename Float, typename yFloat, int nSpin, int nColor, QudaFieldOrder order,
           int writeX, int writeY, int writeZ, int writeW, int writeV, typename Functor>
   void genericBlas(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z,
 		   ColorSpinorField &w, ColorSpinorField &v, Functor f) {
-  colorspinor::FieldOrderCB<Float,nSpin,nColor,1,order> X(x), Z(z), W(w);
-  colorspinor::FieldOrderCB<yFloat,nSpin,nColor,1,order> Y(y), V(v);
-  genericBlas<yFloat,writeX,writeY,writeZ,writeW,writeV>(X, Y, Z, W, V, f);
+  typedef typename mapper<Float>::type RegFloat;
+  typedef typename mapper<yFloat>::type yRegFloat;
+  colorspinor::FieldOrderCB<RegFloat,nSpin,nColor,1,order,Float,Float,false,isFixed<Float>::value> X(x), Z(z), W(w);
+  colorspinor::FieldOrderCB<yRegFloat,nSpin,nColor,1,order,yFloat,yFloat,false,isFixed<yFloat>::value> Y(y), V(v);
+  genericBlas<yRegFloat,nSpin,nColor,writeX,writeY,writeZ,writeW,writeV>(X, Y, Z, W, V, f);
 }
 
 template <typename Float, typename yFloat, int nSpin, QudaFieldOrder order,
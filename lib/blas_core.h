@@ -99,6 +99,12 @@ template <template <typename Float, typename FloatN> class Functor,
     } else if (x.Precision() == QUDA_SINGLE_PRECISION) {
       Functor<float2, float2> f(make_float2(a.x,a.y), make_float2(b.x,b.y), make_float2(c.x,c.y) );
       genericBlas<float, float, writeX, writeY, writeZ, writeW, writeV>(x, y, z, w, v, f);
+    } else if (x.Precision() == QUDA_HALF_PRECISION) {
+      Functor<float2, float2> f(make_float2(a.x,a.y), make_float2(b.x,b.y), make_float2(c.x,c.y) );
+      genericBlas<short, short, writeX, writeY, writeZ, writeW, writeV>(x, y, z, w, v, f);
+    } else if (x.Precision() == QUDA_QUARTER_PRECISION) {
+      Functor<float2, float2> f(make_float2(a.x,a.y), make_float2(b.x,b.y), make_float2(c.x,c.y) );
+      genericBlas<char, char, writeX, writeY, writeZ, writeW, writeV>(x, y, z, w, v, f);
     } else {
       errorQuda("Not implemented");
     }
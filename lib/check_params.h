@@ -447,6 +447,17 @@ void printQudaInvertParam(QudaInvertParam *param) {
   P(secs, INVALID_DOUBLE);
 #endif
 
+#ifdef INIT_PARAM
+  P(history, 0);
+  P(history_max_length, 0);
+  P(history_length, 0);
+  ret.history_file[0] = '\0';
+#elif defined(PRINT_PARAM)
+  P(history_max_length, INVALID_INT);
+  P(history_length, INVALID_INT);
+  if (strlen(param->history_file) > 0) printfQuda("history_file = %s\n", param->history_file);
+#endif
+
 
 #ifdef INIT_PARAM
   //p(ghostDim[0],0);
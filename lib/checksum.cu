@@ -1,5 +1,6 @@
 #include <gauge_field_order.h>
 #include <cub_helper.cuh>
+#include <host_launch.h>
 
 namespace quda {
 
@@ -20,38 +21,44 @@ namespace quda {
   }
 
   template <typename Arg>
-  uint64_t ChecksumCPU(const Arg &arg)
+  uint64_t ChecksumCPU(const Arg &arg, const TuneKey &key)
   {
-    uint64_t checksum_ = 0;
-    for (int parity=0; parity<2; parity++)
-      for (int x_cb=0; x_cb<arg.volumeCB; x_cb++)
-	for (int d=0; d<arg.U.geometry; d++)
-	  checksum_ ^= siteChecksum(arg, d, parity, x_cb);
-    return checksum_;
+    return launchHostReduce(key, 2*arg.volumeCB, static_cast<uint64_t>(0),
+                            [&](int i) {
+                              const int x_cb = i % arg.volumeCB;
+                              const int parity = i / arg.volumeCB;
+                              uint64_t checksum_ = 0;
+                              for (int d=0; d<arg.U.geometry; d++) checksum_ ^= siteChecksum(arg, d, parity, x_cb);
+                              return checksum_;
+                            },
+                            [](uint64_t a, uint64_t b) { return a ^ b; });
   }
 
   template <typename T, int Nc>
   uint64_t Checksum(const GaugeField &u, bool mini)
   {
+    char aux[TuneKey::aux_n];
+    snprintf(aux, TuneKey::aux_n, "order=%d,geometry=%d,prec=%lu%s", u.Order(), u.Geometry(), sizeof(T), mini ? ",mini" : "");
+    const TuneKey key(u.VolString(), "Checksum", aux);
     uint64_t checksum = 0;
     if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
       ChecksumArg<T,QUDA_QDP_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum = ChecksumCPU(arg, key);
     } else if (u.Order() == QUDA_QDPJIT_GAUGE_ORDER) {
       ChecksumArg<T,QUDA_QDPJIT_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum = ChecksumCPU(arg, key);
     } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
       ChecksumArg<T,QUDA_MILC_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum = ChecksumCPU(arg, key);
     } else if (u.Order() == QUDA_BQCD_GAUGE_ORDER) {
       ChecksumArg<T,QUDA_BQCD_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum = ChecksumCPU(arg, key);
     } else if (u.Order() == QUDA_TIFR_GAUGE_ORDER) {
       ChecksumArg<T,QUDA_TIFR_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum = ChecksumCPU(arg, key);
     } else if (u.Order() == QUDA_TIFR_PADDED_GAUGE_ORDER) {
       ChecksumArg<T,QUDA_TIFR_PADDED_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      checksum = ChecksumCPU(arg, key);
     } else {
       errorQuda("Checksum not implemented");
     }    
@@ -43,6 +43,8 @@ namespace quda {
     QudaDirection dir;
     ComputeType type;
 
+    Timer stage_timer[COMPUTE_INVALID]; /** Host time spent in each stage (CPU only) */
+
     long long flops() const
     {
       long long flops_ = 0;
@@ -189,6 +191,7 @@ namespace quda {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 
       if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+        stage_timer[type].Start(__func__, __FILE__, __LINE__);
 
 	if (type == COMPUTE_UV) {
 
@@ -289,6 +292,8 @@ namespace quda {
 	} else {
 	  errorQuda("Undefined compute type %d", type);
 	}
+
+        stage_timer[type].Stop(__func__, __FILE__, __LINE__);
       } else {
 
 	if (type == COMPUTE_UV) {
@@ -549,6 +554,25 @@ namespace quda {
       }
     }
 
+    /**
+       Print the breakdown of the host time spent in each stage of the
+       coarse-operator construction (CPU only)
+    */
+    void printStageTiming() const {
+      if (meta.Location() != QUDA_CPU_FIELD_LOCATION) return;
+      static const char *stage_name[COMPUTE_INVALID] = { "UV", "AV", "TMAV", "TMCAV", "CLOVER_INV_MAX", "VUV",
+                                                         "COARSE_CLOVER", "REVERSE_Y", "DIAGONAL", "TMDIAGONAL",
+                                                         "CONVERT", "RESCALE" };
+      double total = 0.0;
+      for (int i=0; i<COMPUTE_INVALID; i++) total += stage_timer[i].time;
+      for (int i=0; i<COMPUTE_INVALID; i++) {
+        if (stage_timer[i].count == 0) continue;
+        printfQuda("Coarsening stage %-14s = %9.6f secs (%5.1f%%), %3d calls\n", stage_name[i], stage_timer[i].time,
+                   total > 0.0 ? 100.0*stage_timer[i].time/total : 0.0, stage_timer[i].count);
+      }
+      printfQuda("Coarsening total                = %9.6f secs\n", total);
+    }
+
     /**
        Set which dimension we are working on (where applicable)
     */
@@ -1143,6 +1167,7 @@ namespace quda {
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("X2 = %e\n", arg.X.norm2(0));
 
+    if (getVerbosity() >= QUDA_VERBOSE) y.printStageTiming();
   }
 
 
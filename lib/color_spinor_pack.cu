@@ -376,6 +376,10 @@ namespace quda {
       if (comm_dim_partitioned(d)) partitioned = true;
     if (!partitioned) return;
 
+    if (a.Location() == QUDA_CPU_FIELD_LOCATION &&
+        (a.Precision() == QUDA_HALF_PRECISION || a.Precision() == QUDA_QUARTER_PRECISION))
+      errorQuda("Ghost packing of block-float host fields not supported");
+
     if (a.Precision() == QUDA_DOUBLE_PRECISION) {
       if (a.GhostPrecision() == QUDA_DOUBLE_PRECISION) {
         genericPackGhost<double,double>(ghost, a, parity, nFace, dagger, destination);
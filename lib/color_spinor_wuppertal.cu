@@ -7,6 +7,7 @@
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
 #include <tune_quda.h>
+#include <host_launch.h>
 
 namespace quda {
 
@@ -115,18 +116,14 @@ namespace quda {
 
   // CPU kernel for applying a wuppertal smearing step to a vector
   template <typename Float, int Ns, int Nc, typename Arg>
-  void wuppertalStepCPU(Arg arg)
+  void wuppertalStepCPU(Tunable &tunable, Arg &arg)
   {
-
-    for (int parity= 0; parity < arg.nParity; parity++) {
+    launchHost(tunable, arg.nParity * arg.volumeCB, [&](int i) {
+      const int x_cb = i % arg.volumeCB; // 4-d volume
       // for full fields then set parity from loop else use arg setting
-      parity = (arg.nParity == 2) ? parity : arg.parity;
-
-      for (int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
-        computeWupperalStep<Float,Ns,Nc>(arg, x_cb, parity);
-      } // 4-d volumeCB
-    } // parity
-
+      const int parity = (arg.nParity == 2) ? i / arg.volumeCB : arg.parity;
+      computeWupperalStep<Float,Ns,Nc>(arg, x_cb, parity);
+    });
   }
 
   // GPU Kernel for applying a wuppertal smearing step to a vector
@@ -173,7 +170,7 @@ namespace quda {
 
     void apply(const cudaStream_t &stream) {
       if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
-        wuppertalStepCPU<Float,Ns,Nc>(arg);
+        wuppertalStepCPU<Float,Ns,Nc>(*this, arg);
       } else {
         TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
         wuppertalStepGPU<Float,Ns,Nc> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
@@ -57,6 +57,10 @@ void comm_gather_gpuid(int *gpuid_recv_buf) {
   MPI_CHECK(MPI_Allgather(&gpuid, 1, MPI_INT, gpuid_recv_buf, 1, MPI_INT, MPI_COMM_WORLD));
 }
 
+void comm_gather(void *send_buf, void *recv_buf, size_t nbytes) {
+  MPI_CHECK( MPI_Gather(send_buf, (int)nbytes, MPI_BYTE, recv_buf, (int)nbytes, MPI_BYTE, 0, MPI_COMM_WORLD) );
+}
+
 
 void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data)
 {
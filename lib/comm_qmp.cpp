@@ -72,6 +72,33 @@ void comm_gather_gpuid(int *gpuid_recv_buf) {
 #endif
 }
 
+void comm_gather(void *send_buf, void *recv_buf, size_t nbytes) {
+
+#ifdef USE_MPI_GATHER
+  MPI_Gather(send_buf, (int)nbytes, MPI_BYTE, recv_buf, (int)nbytes, MPI_BYTE, 0, MPI_COMM_WORLD);
+#else
+  // point-to-point messages to process 0, which receives them in turn
+  if (comm_rank() == 0) {
+    memcpy(recv_buf, send_buf, nbytes);
+    for (int i=1; i<comm_size(); i++) {
+      QMP_msgmem_t mem = QMP_declare_msgmem(static_cast<char*>(recv_buf) + i*nbytes, nbytes);
+      QMP_msghandle_t handle = QMP_declare_receive_from(mem, i, 0);
+      QMP_CHECK( QMP_start(handle) );
+      QMP_CHECK( QMP_wait(handle) );
+      QMP_free_msghandle(handle);
+      QMP_free_msgmem(mem);
+    }
+  } else {
+    QMP_msgmem_t mem = QMP_declare_msgmem(send_buf, nbytes);
+    QMP_msghandle_t handle = QMP_declare_send_to(mem, 0, 0);
+    QMP_CHECK( QMP_start(handle) );
+    QMP_CHECK( QMP_wait(handle) );
+    QMP_free_msghandle(handle);
+    QMP_free_msgmem(mem);
+  }
+#endif
+}
+
 
 void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data)
 {
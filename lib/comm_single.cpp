@@ -30,6 +30,10 @@ void comm_gather_gpuid(int *gpuid_recv_buf) {
   gpuid_recv_buf[0] = comm_gpuid();
 }
 
+void comm_gather(void *send_buf, void *recv_buf, size_t nbytes) {
+  memcpy(recv_buf, send_buf, nbytes);
+}
+
 MsgHandle *comm_declare_send_displaced(void *buffer, const int displacement[], size_t nbytes)
 { return NULL; }
 
@@ -102,41 +102,41 @@ namespace quda {
     } else {
       if (dst.Precision() == QUDA_DOUBLE_PRECISION) {
         if (src.Precision() == QUDA_DOUBLE_PRECISION) {
-          copyGenericColorSpinorMGDD(dst, src, location, Dst, Src);
+          copyGenericColorSpinorMGDD(dst, src, location, Dst, Src, dstNorm, srcNorm);
         } else if (src.Precision() == QUDA_SINGLE_PRECISION) {
-          copyGenericColorSpinorMGDS(dst, src, location, (double*)Dst, (float*)Src);
+          copyGenericColorSpinorMGDS(dst, src, location, (double*)Dst, (float*)Src, dstNorm, srcNorm);
         } else {
           errorQuda("Unsupported Destination Precision %d with Source Precision %d", dst.Precision(), src.Precision());
         }
       } else if (dst.Precision() == QUDA_SINGLE_PRECISION) {
         if (src.Precision() == QUDA_DOUBLE_PRECISION) {
-          copyGenericColorSpinorMGSD(dst, src, location, (float*)Dst, (double*)Src);
+          copyGenericColorSpinorMGSD(dst, src, location, (float*)Dst, (double*)Src, dstNorm, srcNorm);
         } else if (src.Precision() == QUDA_SINGLE_PRECISION) {
-          copyGenericColorSpinorMGSS(dst, src, location, (float*)Dst, (float*)Src);
+          copyGenericColorSpinorMGSS(dst, src, location, (float*)Dst, (float*)Src, dstNorm, srcNorm);
         } else if (src.Precision() == QUDA_HALF_PRECISION) {
-          copyGenericColorSpinorMGSH(dst, src, location, (float*)Dst, (short*)Src);
+          copyGenericColorSpinorMGSH(dst, src, location, (float*)Dst, (short*)Src, dstNorm, srcNorm);
         } else if (src.Precision() == QUDA_QUARTER_PRECISION) {
-          copyGenericColorSpinorMGSQ(dst, src, location, (float*)Dst, (char*)Src);
+          copyGenericColorSpinorMGSQ(dst, src, location, (float*)Dst, (char*)Src, dstNorm, srcNorm);
         } else {
           errorQuda("Unsupported Destination Precision %d with Source Precision %d", dst.Precision(), src.Precision());
         }
       } else if (dst.Precision() == QUDA_HALF_PRECISION) {
         if (src.Precision() == QUDA_SINGLE_PRECISION) {
-          copyGenericColorSpinorMGHS(dst, src, location, (short*)Dst, (float*)Src);
+          copyGenericColorSpinorMGHS(dst, src, location, (short*)Dst, (float*)Src, dstNorm, srcNorm);
         } else if (src.Precision() == QUDA_HALF_PRECISION) {
-          copyGenericColorSpinorMGHH(dst, src, location, (short*)Dst, (short*)Src);
+          copyGenericColorSpinorMGHH(dst, src, location, (short*)Dst, (short*)Src, dstNorm, srcNorm);
         } else if (src.Precision() == QUDA_QUARTER_PRECISION) {
-          copyGenericColorSpinorMGHQ(dst, src, location, (short*)Dst, (char*)Src);
+          copyGenericColorSpinorMGHQ(dst, src, location, (short*)Dst, (char*)Src, dstNorm, srcNorm);
         } else {
           errorQuda("Unsupported Destination Precision %d with Source Precision %d", dst.Precision(), src.Precision());
         }
       } else if (dst.Precision() == QUDA_QUARTER_PRECISION) {
         if (src.Precision() == QUDA_SINGLE_PRECISION) {
-          copyGenericColorSpinorMGQS(dst, src, location, (char*)Dst, (float*)Src);
+          copyGenericColorSpinorMGQS(dst, src, location, (char*)Dst, (float*)Src, dstNorm, srcNorm);
         } else if (src.Precision() == QUDA_HALF_PRECISION) {
-          copyGenericColorSpinorMGQH(dst, src, location, (char*)Dst, (short*)Src);
+          copyGenericColorSpinorMGQH(dst, src, location, (char*)Dst, (short*)Src, dstNorm, srcNorm);
         } else if (src.Precision() == QUDA_QUARTER_PRECISION) {
-          copyGenericColorSpinorMGQQ(dst, src, location, (char*)Dst, (char*)Src);
+          copyGenericColorSpinorMGQQ(dst, src, location, (char*)Dst, (char*)Src, dstNorm, srcNorm);
         } else {
           errorQuda("Unsupported Destination Precision %d with Source Precision %d", dst.Precision(), src.Precision());
         }
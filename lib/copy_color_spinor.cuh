@@ -11,6 +11,7 @@
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
 #include <tune_quda.h>
+#include <host_launch.h>
 #include <utility> // for std::swap
 
 #define PRESERVE_SPINOR_NORM
@@ -120,18 +121,18 @@ namespace quda {
 
   /** CPU function to reorder spinor fields.  */
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename Arg, typename Basis>
-  void copyColorSpinor(Arg &arg, const Basis &basis) {
+  void copyColorSpinor(Tunable &tunable, Arg &arg, const Basis &basis) {
     typedef typename mapper<FloatIn>::type RegTypeIn;
     typedef typename mapper<FloatOut>::type RegTypeOut;
 
-    for (int parity = 0; parity<arg.nParity; parity++) {
-      for (int x=0; x<arg.volumeCB; x++) {
-	ColorSpinor<RegTypeIn, Nc, Ns> in = arg.in(x, (parity+arg.inParity)&1);
-	ColorSpinor<RegTypeOut, Nc, Ns> out;
-	basis(out.data, in.data);
-	arg.out(x, (parity+arg.outParity)&1) = out;
-      }
-    }
+    launchHost(tunable, arg.nParity * arg.volumeCB, [&](int i) {
+      const int x = i % arg.volumeCB;
+      const int parity = i / arg.volumeCB;
+      ColorSpinor<RegTypeIn, Nc, Ns> in = arg.in(x, (parity+arg.inParity)&1);
+      ColorSpinor<RegTypeOut, Nc, Ns> out;
+      basis(out.data, in.data);
+      arg.out(x, (parity+arg.outParity)&1) = out;
+    });
   }
 
   /** CUDA kernel to reorder spinor fields.  Adopts a similar form as the CPU version, using the same inlined functions. */
@@ -174,7 +175,7 @@ namespace quda {
   
     void apply(const cudaStream_t &stream) {
       if (location == QUDA_CPU_FIELD_LOCATION) {
-	copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, PreserveBasis<Ns,Nc>());
+	copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(*this, arg, PreserveBasis<Ns,Nc>());
       } else {
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	copyColorSpinorKernel<FloatOut, FloatIn, Ns, Nc>
@@ -226,15 +227,15 @@ namespace quda {
     void apply(const cudaStream_t &stream) {
       if (location == QUDA_CPU_FIELD_LOCATION) {
 	if (out.GammaBasis()==in.GammaBasis()) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, PreserveBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(*this, arg, PreserveBasis<Ns,Nc>());
 	} else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, NonRelBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(*this, arg, NonRelBasis<Ns,Nc>());
 	} else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, RelBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(*this, arg, RelBasis<Ns,Nc>());
 	} else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, ChiralToNonRelBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(*this, arg, ChiralToNonRelBasis<Ns,Nc>());
 	} else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, NonRelToChiralBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(*this, arg, NonRelToChiralBasis<Ns,Nc>());
 	}
       } else {
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
@@ -293,7 +294,7 @@ namespace quda {
       genericCopyColorSpinor<FloatOut,FloatIn,4,Nc>
 	(outOrder, inOrder, out, in, location);
     } else if (out.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      SpaceSpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, 1, Out);
+      SpaceSpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, 1, Out, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
 	(outOrder, inOrder, out, in, location);
     } else if (out.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
@@ -303,7 +304,7 @@ namespace quda {
     } else if (out.FieldOrder() == QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER) {
 
 #ifdef BUILD_TIFR_INTERFACE
-      PaddedSpaceSpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, 1, Out);
+      PaddedSpaceSpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, 1, Out, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
 	(outOrder, inOrder, out, in, location);
 #else
@@ -341,7 +342,7 @@ namespace quda {
       ColorSpinor inOrder(in, 1, In, inNorm, nullptr, override);
       genericCopyColorSpinor<FloatOut,FloatIn,4,Nc>(inOrder, out, in, location, Out, outNorm);
     } else if (in.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      SpaceSpinorColorOrder<FloatIn, Ns, Nc> inOrder(in, 1, In);
+      SpaceSpinorColorOrder<FloatIn, Ns, Nc> inOrder(in, 1, In, inNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in, location, Out, outNorm);
     } else if (in.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
       SpaceColorSpinorOrder<FloatIn, Ns, Nc> inOrder(in, 1, In);
@@ -17,10 +17,19 @@ namespace quda {
 
   using namespace colorspinor;
 
-  /** CPU function to reorder spinor fields.  */
-  template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename OutOrder, typename InOrder>
-    void packSpinor(OutOrder &outOrder, const InOrder &inOrder, int volume) {
-    for (int x=0; x<volume; x++) {
+  /**
+     Copy a single site between orders.  When the output stores a
+     per-site norm (host block-float fields) the whole site is staged
+     in registers so that the norm can be computed before the write.
+  */
+  template <typename FloatOut, int Ns, int Nc, typename OutOrder, typename InOrder>
+  __device__ __host__ inline void copySite(OutOrder &outOrder, const InOrder &inOrder, int x) {
+    if (OutOrder::site_norm) {
+      typedef typename mapper<FloatOut>::type RegType;
+      complex<RegType> tmp[Ns*Nc];
+      inOrder.load(tmp, 0, x);
+      outOrder.save(tmp, 0, x);
+    } else {
       for (int s=0; s<Ns; s++) {
 	for (int c=0; c<Nc; c++) {
 	  outOrder(0, x, s, c) = inOrder(0, x, s, c);
@@ -29,17 +38,19 @@ namespace quda {
     }
   }
 
+  /** CPU function to reorder spinor fields.  */
+  template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename OutOrder, typename InOrder>
+    void packSpinor(OutOrder &outOrder, const InOrder &inOrder, int volume) {
+    for (int x=0; x<volume; x++) copySite<FloatOut,Ns,Nc>(outOrder, inOrder, x);
+  }
+
   /** CUDA kernel to reorder spinor fields.  Adopts a similar form as the CPU version, using the same inlined functions. */
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename OutOrder, typename InOrder>
     __global__ void packSpinorKernel(OutOrder outOrder, const InOrder inOrder, int volume) {
     int x = blockIdx.x * blockDim.x + threadIdx.x;
     if (x >= volume) return;
 
-    for (int s=0; s<Ns; s++) {
-      for (int c=0; c<Nc; c++) {
-	outOrder(0, x, s, c) = inOrder(0, x, s, c);
-      }
-    }
+    copySite<FloatOut,Ns,Nc>(outOrder, inOrder, x);
   }
 
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename OutOrder, typename InOrder>
@@ -90,15 +101,17 @@ namespace quda {
   /** Decide on the output order*/
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename InOrder>
     void genericCopyColorSpinor(InOrder &inOrder, ColorSpinorField &out,
-				QudaFieldLocation location, FloatOut *Out) {
+				QudaFieldLocation location, FloatOut *Out, float *outNorm) {
 
     if (out.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
       typedef typename colorspinor::FieldOrderCB<typename mapper<FloatOut>::type, Ns, Nc, 1, QUDA_FLOAT2_FIELD_ORDER,FloatOut> ColorSpinor;
       ColorSpinor outOrder(out, 1, Out);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(outOrder, inOrder, out, location);
     } else if (out.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      typedef typename colorspinor::FieldOrderCB<typename mapper<FloatOut>::type, Ns, Nc, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,FloatOut> ColorSpinor;
-      ColorSpinor outOrder(out, 1, Out);
+      // fixed-point fields in this order are host fields stored in block-float format
+      typedef typename colorspinor::FieldOrderCB<typename mapper<FloatOut>::type, Ns, Nc, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,
+                                                 FloatOut, FloatOut, false, isFixed<FloatOut>::value> ColorSpinor;
+      ColorSpinor outOrder(out, 1, Out, 0, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(outOrder, inOrder, out, location);
     } else {
       errorQuda("Order %d not defined (Ns=%d, Nc=%d)", out.FieldOrder(), Ns, Nc);
@@ -109,16 +122,18 @@ namespace quda {
   /** Decide on the input order*/
   template <typename FloatOut, typename FloatIn, int Ns, int Nc>
     void genericCopyColorSpinor(ColorSpinorField &out, const ColorSpinorField &in,
-				QudaFieldLocation location, FloatOut *Out, FloatIn *In) {
+				QudaFieldLocation location, FloatOut *Out, FloatIn *In,
+				float *outNorm, float *inNorm) {
 
     if (in.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
       typedef typename colorspinor::FieldOrderCB<typename mapper<FloatIn>::type, Ns, Nc, 1, QUDA_FLOAT2_FIELD_ORDER,FloatIn> ColorSpinor;
       ColorSpinor inOrder(in, 1, In);
-      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, location, Out);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, location, Out, outNorm);
     } else if (in.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      typedef typename colorspinor::FieldOrderCB<typename mapper<FloatIn>::type, Ns, Nc, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,FloatIn> ColorSpinor;
-      ColorSpinor inOrder(in, 1, In);
-      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, location, Out);
+      typedef typename colorspinor::FieldOrderCB<typename mapper<FloatIn>::type, Ns, Nc, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,
+                                                 FloatIn, FloatIn, false, isFixed<FloatIn>::value> ColorSpinor;
+      ColorSpinor inOrder(in, 1, In, 0, inNorm);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, location, Out, outNorm);
     } else {
       errorQuda("Order %d not defined (Ns=%d, Nc=%d)", in.FieldOrder(), Ns, Nc);
     }
@@ -128,7 +143,8 @@ namespace quda {
 
   template <int Ns, int Nc, typename dstFloat, typename srcFloat>
     void copyGenericColorSpinor(ColorSpinorField &dst, const ColorSpinorField &src,
-				QudaFieldLocation location, dstFloat *Dst, srcFloat *Src) {
+				QudaFieldLocation location, dstFloat *Dst, srcFloat *Src,
+				float *dstNorm, float *srcNorm) {
 
     if (dst.Ndim() != src.Ndim())
       errorQuda("Number of dimensions %d %d don't match", dst.Ndim(), src.Ndim());
@@ -161,28 +177,35 @@ namespace quda {
       // set for the source subset ordering
       srcFloat *srcEven = Src ? Src : (srcFloat*)src.V();
       srcFloat *srcOdd = (srcFloat*)((char*)srcEven + src.Bytes()/2);
+      float *srcNormEven = srcNorm ? srcNorm : (float*)src.Norm();
+      float *srcNormOdd = (float*)((char*)srcNormEven + src.NormBytes()/2);
       if (src.SiteOrder() == QUDA_ODD_EVEN_SITE_ORDER) {
 	std::swap<srcFloat*>(srcEven, srcOdd);
+	std::swap<float*>(srcNormEven, srcNormOdd);
       }
 
       // set for the destination subset ordering
       dstFloat *dstEven = Dst ? Dst : (dstFloat*)dst.V();
       dstFloat *dstOdd = (dstFloat*)((char*)dstEven + dst.Bytes()/2);
+      float *dstNormEven = dstNorm ? dstNorm : (float*)dst.Norm();
+      float *dstNormOdd = (float*)((char*)dstNormEven + dst.NormBytes()/2);
       if (dst.SiteOrder() == QUDA_ODD_EVEN_SITE_ORDER) {
 	std::swap<dstFloat*>(dstEven, dstOdd);
+	std::swap<float*>(dstNormEven, dstNormOdd);
       }
 
-      genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>(dst, src, location, dstEven, srcEven);
-      genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>(dst, src, location,  dstOdd,  srcOdd);
+      genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>(dst, src, location, dstEven, srcEven, dstNormEven, srcNormEven);
+      genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>(dst, src, location,  dstOdd,  srcOdd,  dstNormOdd,  srcNormOdd);
     } else { // parity field
-      genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>(dst, src, location, Dst, Src);
+      genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>(dst, src, location, Dst, Src, dstNorm, srcNorm);
     }
 
   }
 
   template <int Nc, typename dstFloat, typename srcFloat>
   void CopyGenericColorSpinor(ColorSpinorField &dst, const ColorSpinorField &src,
-			      QudaFieldLocation location, dstFloat *Dst, srcFloat *Src)
+			      QudaFieldLocation location, dstFloat *Dst, srcFloat *Src,
+			      float *dstNorm=0, float *srcNorm=0)
   {
 
     if (dst.Nspin() != src.Nspin())
@@ -190,19 +213,19 @@ namespace quda {
 
     if (dst.Nspin() == 4) {
 #if defined(GPU_WILSON_DIRAC) || defined(GPU_DOMAIN_WALL_DIRAC)
-      copyGenericColorSpinor<4,Nc>(dst, src, location, Dst, Src);
+      copyGenericColorSpinor<4,Nc>(dst, src, location, Dst, Src, dstNorm, srcNorm);
 #else
       errorQuda("%s has not been built for Nspin=%d fields", __func__, src.Nspin());
 #endif
     } else if (dst.Nspin() == 2) {
 #if defined(GPU_WILSON_DIRAC) || defined(GPU_DOMAIN_WALL_DIRAC) || defined(GPU_STAGGERED_DIRAC)
-      copyGenericColorSpinor<2,Nc>(dst, src, location, Dst, Src);
+      copyGenericColorSpinor<2,Nc>(dst, src, location, Dst, Src, dstNorm, srcNorm);
 #else
       errorQuda("%s has not been built for Nspin=%d fields", __func__, src.Nspin());
 #endif
     } else if (dst.Nspin() == 1) {
 #ifdef GPU_STAGGERED_DIRAC
-      copyGenericColorSpinor<1,Nc>(dst, src, location, Dst, Src);
+      copyGenericColorSpinor<1,Nc>(dst, src, location, Dst, Src, dstNorm, srcNorm);
 #else
       errorQuda("%s has not been built for Nspin=%d fields", __func__, src.Nspin());
 #endif
@@ -216,58 +239,58 @@ namespace quda {
 #define INSTANTIATE_COLOR						\
   switch(src.Ncolor()) {						\
   case 1:								\
-    CopyGenericColorSpinor<1>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<1>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 2:								\
-    CopyGenericColorSpinor<2>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<2>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 4:								\
-    CopyGenericColorSpinor<4>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<4>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 6:								\
-    CopyGenericColorSpinor<6>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<6>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 9:								\
-    CopyGenericColorSpinor<9>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<9>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 12:								\
-    CopyGenericColorSpinor<12>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<12>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 16:								\
-    CopyGenericColorSpinor<16>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<16>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 18:                \
-    CopyGenericColorSpinor<18>(dst, src, location, dst_ptr, src_ptr); \
+    CopyGenericColorSpinor<18>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm); \
     break;                \
   case 24:								\
-    CopyGenericColorSpinor<24>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<24>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 32:								\
-    CopyGenericColorSpinor<32>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<32>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 36:								\
-    CopyGenericColorSpinor<36>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<36>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 48:								\
-    CopyGenericColorSpinor<48>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<48>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 72:								\
-    CopyGenericColorSpinor<72>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<72>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 96:								\
-    CopyGenericColorSpinor<96>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<96>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 256:								\
-    CopyGenericColorSpinor<256>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<256>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 576:								\
-    CopyGenericColorSpinor<576>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<576>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 768:								\
-    CopyGenericColorSpinor<768>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<768>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   case 1024:								\
-    CopyGenericColorSpinor<1024>(dst, src, location, dst_ptr, src_ptr);	\
+    CopyGenericColorSpinor<1024>(dst, src, location, dst_ptr, src_ptr, dst_norm, src_norm);	\
     break;								\
   default:								\
     errorQuda("Ncolors=%d not supported", src.Ncolor());		\
@@ -9,6 +9,8 @@ namespace quda {
 #if defined(GPU_MULTIGRID)
     double *dst_ptr = static_cast<double*>(Dst);
     double *src_ptr = static_cast<double*>(Src);
+    float *dst_norm = static_cast<float*>(dstNorm);
+    float *src_norm = static_cast<float*>(srcNorm);
 
     INSTANTIATE_COLOR;
 #else
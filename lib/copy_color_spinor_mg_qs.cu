@@ -9,6 +9,8 @@ namespace quda {
 #if defined(GPU_MULTIGRID)
     char *dst_ptr = static_cast<char*>(Dst);
     float *src_ptr = static_cast<float*>(Src);
+    float *dst_norm = static_cast<float*>(dstNorm);
+    float *src_norm = static_cast<float*>(srcNorm);
 
     INSTANTIATE_COLOR;
 #else
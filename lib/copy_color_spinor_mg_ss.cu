@@ -9,6 +9,8 @@ namespace quda {
 #ifdef GPU_MULTIGRID
     float *dst_ptr = static_cast<float*>(Dst);
     float *src_ptr = static_cast<float*>(Src);
+    float *dst_norm = static_cast<float*>(dstNorm);
+    float *src_norm = static_cast<float*>(srcNorm);
 
     INSTANTIATE_COLOR;
 #else
@@ -1,4 +1,5 @@
 #include <tune_quda.h>
+#include <host_launch.h>
 
 #include <jitify_helper.cuh>
 #include <kernels/copy_gauge.cuh>
@@ -22,11 +23,6 @@ namespace quda {
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return size; }
 
-    bool advanceTuneParam(TuneParam &param) const {
-      // only do autotuning if we are doing the copy on the GPU
-      return location == QUDA_CUDA_FIELD_LOCATION ? TunableVectorYZ::advanceTuneParam(param) : false;
-    }
-
 public:
     CopyGauge(Arg &arg, const GaugeField &out, const GaugeField &in, QudaFieldLocation location)
 #ifndef FINE_GRAINED_ACCESS
@@ -80,14 +76,21 @@ public:
     virtual ~CopyGauge() { ; }
   
     void apply(const cudaStream_t &stream) {
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (location == QUDA_CPU_FIELD_LOCATION) {
-        if (!is_ghost) {
-          copyGauge<FloatOut, FloatIn, length>(arg);
-        } else {
-          copyGhost<FloatOut, FloatIn, length>(arg);
-        }
+        // one iteration per link, with x running fastest, then the direction, then parity
+        const int n_dir = is_ghost ? (int)arg.nDim : (int)arg.geometry;
+        launchHost(*this, 2 * n_dir * size, [&](int i) {
+          const int x = i % size;
+          const int d = (i / size) % n_dir;
+          const int parity = i / (size * n_dir);
+          if (!is_ghost) {
+            copyGauge<FloatOut, FloatIn, length>(arg, x, d, parity);
+          } else if (x < arg.faceVolumeCB[d]) {
+            copyGhost<FloatOut, FloatIn, length>(arg, x, d, parity);
+          }
+        });
       } else if (location == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 #ifdef JITIFY
         using namespace jitify::reflection;
         jitify_error = program->kernel(!is_ghost ? "quda::copyGaugeKernel" : "quda::copyGhostKernel")
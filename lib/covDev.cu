@@ -6,6 +6,7 @@
 #include <stencil.h>
 #include <color_spinor.h>
 #include <tune_quda.h>
+#include <host_launch.h>
 #include <worker.h>
 
 /**
@@ -131,18 +132,14 @@ namespace quda {
 
   // CPU kernel for applying the Laplace operator to a vector
   template <typename Float, int nDim, int nSpin, int nColor, typename Arg>
-  void covDevCPU(Arg arg)
+  void covDevCPU(Tunable &tunable, Arg &arg)
   {
-
-    for (int parity= 0; parity < arg.nParity; parity++) {
+    launchHost(tunable, arg.nParity * arg.volumeCB, [&](int i) {
+      const int x_cb = i % arg.volumeCB; // 4-d volume
       // for full fields then set parity from loop else use arg setting
-      parity = (arg.nParity == 2) ? parity : arg.parity;
-
-      for (int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
-	covDev<Float,nDim,nSpin,nColor>(arg, x_cb, parity);
-      } // 4-d volumeCB
-    } // parity
-
+      const int parity = (arg.nParity == 2) ? i / arg.volumeCB : arg.parity;
+      covDev<Float,nDim,nSpin,nColor>(arg, x_cb, parity);
+    });
   }
 
   // GPU Kernel for applying the Laplace operator to a vector
@@ -197,7 +194,7 @@ namespace quda {
 
     void apply(const cudaStream_t &stream) {
       if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
-	covDevCPU<Float,nDim,nSpin,nColor>(arg);
+	covDevCPU<Float,nDim,nSpin,nColor>(*this, arg);
       } else {
         TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	covDevGPU<Float,nDim,nSpin,nColor> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
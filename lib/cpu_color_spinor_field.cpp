@@ -22,6 +22,7 @@ namespace quda {
     // need to set this before create
     if (param.create == QUDA_REFERENCE_FIELD_CREATE) {
       v = param.v;
+      norm = param.norm;
       reference = true;
     }
 
@@ -40,6 +41,7 @@ namespace quda {
     ColorSpinorField(src), init(false), reference(false) {
     create(QUDA_COPY_FIELD_CREATE);
     memcpy(v,src.v,bytes);
+    if (norm_bytes) memcpy(norm, src.norm, norm_bytes);
   }
 
   cpuColorSpinorField::cpuColorSpinorField(const ColorSpinorField &src) : 
@@ -47,6 +49,7 @@ namespace quda {
     create(QUDA_COPY_FIELD_CREATE);
     if (typeid(src) == typeid(cpuColorSpinorField)) {
       memcpy(v, dynamic_cast<const cpuColorSpinorField&>(src).v, bytes);
+      if (norm_bytes) memcpy(norm, dynamic_cast<const cpuColorSpinorField&>(src).norm, norm_bytes);
     } else if (typeid(src) == typeid(cudaColorSpinorField)) {
       dynamic_cast<const cudaColorSpinorField&>(src).saveSpinorField(*this);
     } else {
@@ -132,8 +135,10 @@ namespace quda {
 
 
     if (pad != 0) errorQuda("Non-zero pad not supported");  
-    if (precision == QUDA_HALF_PRECISION) errorQuda("Half precision not supported");
-    if (precision == QUDA_QUARTER_PRECISION) errorQuda("Quarter precision not supported");
+    // host fixed-point fields are stored in block-float format, with a norm per site
+    if ((precision == QUDA_HALF_PRECISION || precision == QUDA_QUARTER_PRECISION) &&
+        fieldOrder != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+      errorQuda("Precision %d only supported with field order %d", precision, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER);
 
     if (fieldOrder != QUDA_SPACE_COLOR_SPIN_FIELD_ORDER && 
 	fieldOrder != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
@@ -152,6 +157,7 @@ namespace quda {
       } else {
         v = safe_malloc(bytes);
       }
+      if (norm_bytes) norm = safe_malloc(norm_bytes);
       init = true;
     }
  
@@ -189,6 +195,7 @@ namespace quda {
       if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) 
 	for (int i=0; i<x[nDim-1]; i++) host_free(((void**)v)[i]);
       host_free(v);
+      if (norm_bytes) host_free(norm);
       init = false;
     }
 
@@ -206,6 +213,7 @@ namespace quda {
         for (int i=0; i<x[nDim-1]; i++) memcpy(((void**)v)[i], ((void**)src.v)[i], bytes/x[nDim-1]);
       else 
         memcpy(v, src.v, bytes);
+      if (norm_bytes) memcpy(norm, src.norm, norm_bytes);
     } else {
       copyGenericColorSpinor(*this, src, QUDA_CPU_FIELD_LOCATION);
     }
@@ -241,6 +249,7 @@ namespace quda {
   void cpuColorSpinorField::zero() {
     if (fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) memset(v, '\0', bytes);
     else for (int i=0; i<x[nDim-1]; i++) memset(((void**)v)[i], '\0', bytes/x[nDim-1]);
+    if (norm_bytes) memset(norm, '\0', norm_bytes);
   }
 
   void cpuColorSpinorField::Source(QudaSourceType source_type, int x, int s, int c) {
@@ -3,6 +3,9 @@
 #include <uint_to_char.h>
 #include <worker.h>
 #include <tune_quda.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <jitify_helper.cuh>
 #include <kernels/dslash_coarse.cuh>
@@ -31,6 +34,8 @@ namespace quda {
     const int nSrc;
 
     const int max_color_col_stride = 8;
+    const int max_host_color_block = 8;
+    const int max_host_src_block = 8;
     mutable int color_col_stride;
     mutable int dim_threads;
     char *saveOut;
@@ -147,8 +152,82 @@ namespace quda {
       }
     }
 
+    /**
+       On the host we tune the number of output colors computed per
+       pass (aux.x), the number of threads (aux.y) and, for
+       multi-source fields, the number of sources each link is applied
+       to per load (aux.z).  The color block must divide Nc and be one
+       of the instantiated sizes; it is only used when aux.z = 1.
+     */
+    static int maxHostThreads()
+    {
+#ifdef _OPENMP
+      return omp_get_max_threads();
+#else
+      return 1;
+#endif
+    }
+
+    /**
+       @return The largest instantiated source block size that does not exceed nSrc
+     */
+    int maxHostSrcBlock() const
+    {
+      int src_block = 1;
+      while (2*src_block <= max_host_src_block && 2*src_block <= nSrc) src_block *= 2;
+      return src_block;
+    }
+
+    /**
+       @return Whether the spinors are host block-float fields, which
+       are only supported by the whole-site kernel with a single source
+       per block, so only the thread count is tuned
+     */
+    bool hostFixed() const
+    {
+      return out.Precision() == QUDA_HALF_PRECISION || out.Precision() == QUDA_QUARTER_PRECISION;
+    }
+
+    bool advanceHostParam(TuneParam &param) const
+    {
+      if (!hostFixed() && param.aux.z == 1 && 2*param.aux.x <= max_host_color_block && Nc % (2*param.aux.x) == 0) {
+	param.aux.x *= 2;
+	return true;
+      }
+      param.aux.x = 1;
+
+      if (param.aux.y < maxHostThreads()) {
+	param.aux.y = std::min(2*param.aux.y, maxHostThreads());
+	return true;
+      }
+      param.aux.y = 1;
+
+      if (!hostFixed() && param.aux.z < maxHostSrcBlock()) {
+	param.aux.z *= 2;
+	return true;
+      }
+      param.aux.z = 1;
+      return false;
+    }
+
+    void initHostParam(TuneParam &param) const
+    {
+      param.block = dim3(1,1,1);
+      param.grid = dim3(1,1,1);
+      param.shared_bytes = 0;
+      param.aux = make_int4(1,1,1,1);
+    }
+
+    bool advanceTuneParam(TuneParam &param) const
+    {
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) return advanceHostParam(param);
+      else return TunableVectorY::advanceTuneParam(param);
+    }
+
     virtual void initTuneParam(TuneParam &param) const
     {
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) { initHostParam(param); return; }
+
       param.aux = make_int4(1,1,1,1);
       color_col_stride = param.aux.x;
       dim_threads = param.aux.y;
@@ -163,6 +242,13 @@ namespace quda {
     /** sets default values for when tuning is disabled */
     virtual void defaultTuneParam(TuneParam &param) const
     {
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) {
+	initHostParam(param);
+	param.aux.y = maxHostThreads();
+	param.aux.z = hostFixed() ? 1 : maxHostSrcBlock();
+	return;
+      }
+
       param.aux = make_int4(1,1,1,1);
       color_col_stride = param.aux.x;
       dim_threads = param.aux.y;
@@ -216,6 +302,8 @@ namespace quda {
 	label[14] = '\0';
 	strcat(aux,label);
       }
+
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
     }
     virtual ~DslashCoarse() { }
 
@@ -226,8 +314,36 @@ namespace quda {
 	if (out.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || Y.FieldOrder() != QUDA_QDP_GAUGE_ORDER)
 	  errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", inA.FieldOrder(), Y.FieldOrder());
 
+	const TuneParam &tp = tuneLaunch(*this, getTuning(), getVerbosity());
+
+	if (out.Precision() == QUDA_HALF_PRECISION) {
+	  DslashCoarseArg<Float,yFloat,ghostFloat,Ns,Nc,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,QUDA_QDP_GAUGE_ORDER,short> arg(out, inA, inB, Y, X, (Float)kappa, parity);
+	  coarseDslashMultiSrc<Float,nDim,Ns,Nc,1,dslash,clover,dagger,type>(arg, tp.aux.y);
+	  return;
+	} else if (out.Precision() == QUDA_QUARTER_PRECISION) {
+	  DslashCoarseArg<Float,yFloat,ghostFloat,Ns,Nc,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,QUDA_QDP_GAUGE_ORDER,char> arg(out, inA, inB, Y, X, (Float)kappa, parity);
+	  coarseDslashMultiSrc<Float,nDim,Ns,Nc,1,dslash,clover,dagger,type>(arg, tp.aux.y);
+	  return;
+	}
+
 	DslashCoarseArg<Float,yFloat,ghostFloat,Ns,Nc,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,QUDA_QDP_GAUGE_ORDER> arg(out, inA, inB, Y, X, (Float)kappa, parity);
-	coarseDslash<Float,nDim,Ns,Nc,Mc,dslash,clover,dagger,type>(arg);
+	if (tp.aux.z > 1) {
+	  switch (tp.aux.z) { // this is the host source block size
+	  case 2: coarseDslashMultiSrc<Float,nDim,Ns,Nc,2,dslash,clover,dagger,type>(arg, tp.aux.y); break;
+	  case 4: coarseDslashMultiSrc<Float,nDim,Ns,Nc,4,dslash,clover,dagger,type>(arg, tp.aux.y); break;
+	  case 8: coarseDslashMultiSrc<Float,nDim,Ns,Nc,8,dslash,clover,dagger,type>(arg, tp.aux.y); break;
+	  default: errorQuda("Host source block size %d not valid", tp.aux.z);
+	  }
+	} else {
+	  if (Nc % tp.aux.x != 0) errorQuda("Host color block size %d does not divide Nc=%d", tp.aux.x, Nc);
+	  switch (tp.aux.x) { // this is the host color block size
+	  case 1: coarseDslash<Float,nDim,Ns,Nc,1,dslash,clover,dagger,type>(arg, tp.aux.y); break;
+	  case 2: coarseDslash<Float,nDim,Ns,Nc,2,dslash,clover,dagger,type>(arg, tp.aux.y); break;
+	  case 4: coarseDslash<Float,nDim,Ns,Nc,4,dslash,clover,dagger,type>(arg, tp.aux.y); break;
+	  case 8: coarseDslash<Float,nDim,Ns,Nc,8,dslash,clover,dagger,type>(arg, tp.aux.y); break;
+	  default: errorQuda("Host color block size %d not valid", tp.aux.x);
+	  }
+	}
       } else {
 
         const TuneParam &tp = tuneLaunch(*this, getTuning(), getVerbosity());
@@ -317,16 +433,27 @@ namespace quda {
     }
 
     void preTune() {
+      // host fields also back up their norms
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) { out.backup(); return; }
       saveOut = new char[out.Bytes()];
       cudaMemcpy(saveOut, out.V(), out.Bytes(), cudaMemcpyDeviceToHost);
     }
 
     void postTune()
     {
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) { out.restore(); return; }
       cudaMemcpy(out.V(), saveOut, out.Bytes(), cudaMemcpyHostToDevice);
       delete[] saveOut;
     }
 
+    std::string paramString(const TuneParam &param) const
+    {
+      if (out.Location() != QUDA_CPU_FIELD_LOCATION) return TunableVectorY::paramString(param);
+      std::stringstream ps;
+      ps << "color_block=" << param.aux.x << ", threads=" << param.aux.y << ", src_block=" << param.aux.z;
+      return ps.str();
+    }
+
   };
 
 
@@ -553,7 +680,10 @@ namespace quda {
 #else
 	errorQuda("Double precision multigrid has not been enabled");
 #endif
-      } else if (precision == QUDA_SINGLE_PRECISION) {
+      } else if (precision == QUDA_SINGLE_PRECISION ||
+                 (out.Location() == QUDA_CPU_FIELD_LOCATION &&
+                  (precision == QUDA_HALF_PRECISION || precision == QUDA_QUARTER_PRECISION))) {
+        // host half and quarter spinors are block-float fields that are computed on in single precision
         if (Y.Precision() == QUDA_SINGLE_PRECISION) {
           if (halo_precision == QUDA_SINGLE_PRECISION) {
             ApplyCoarse<float,float,float>(out, inA, inB, Y, X, kappa, parity, dslash, clover,
@@ -590,7 +720,8 @@ namespace quda {
 
   // hooks into tune.cpp variables for policy tuning
   typedef std::map<TuneKey, TuneParam> map;
-  const map& getTuneCache();
+  map getTuneCache();
+  bool tuneCacheContains(const TuneKey &key);
 
   void disableProfileCount();
   void enableProfileCount();
@@ -687,7 +818,7 @@ namespace quda {
 
       // before we do policy tuning we must ensure the kernel
       // constituents have been tuned since we can't do nested tuning
-      if (getTuning() && getTuneCache().find(tuneKey()) == getTuneCache().end()) {
+      if (getTuning() && !tuneCacheContains(tuneKey())) {
 	disableProfileCount();
 	for (auto &i : policies) if(i!= DslashCoarsePolicy::DSLASH_COARSE_POLICY_DISABLED) dslash(i);
 	enableProfileCount();
@@ -768,6 +899,12 @@ namespace quda {
 	           const GaugeField &Y, const GaugeField &X, double kappa, int parity,
 		   bool dslash, bool clover, bool dagger, const int *commDim, QudaPrecision halo_precision) {
 
+    // host half and quarter spinors carry a norm per site, for which there is no host halo packer
+    if (dslash && comm_partitioned() && (!commDim || commDim[0] || commDim[1] || commDim[2] || commDim[3]) &&
+        out.Location() == QUDA_CPU_FIELD_LOCATION &&
+        (inA.Precision() == QUDA_HALF_PRECISION || inA.Precision() == QUDA_QUARTER_PRECISION))
+      errorQuda("Host coarse dslash with precision %d spinors is not supported on a partitioned lattice", inA.Precision());
+
     DslashCoarseLaunch Dslash(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, commDim, halo_precision);
 
     DslashCoarsePolicyTune policy(Dslash);
@@ -2,7 +2,8 @@ static cudaColorSpinorField *inSpinor;
 
 // hooks into tune.cpp variables for policy tuning
 typedef std::map<TuneKey, TuneParam> map;
-const map& getTuneCache();
+map getTuneCache();
+bool tuneCacheContains(const TuneKey &key);
 
 void disableProfileCount();
 void enableProfileCount();
@@ -2033,7 +2034,7 @@ struct DslashFactory {
 
      // before we do policy tuning we must ensure the kernel
      // constituents have been tuned since we can't do nested tuning
-     if (getTuning() && getTuneCache().find(tuneKey()) == getTuneCache().end()) {
+     if (getTuning() && !tuneCacheContains(tuneKey())) {
        disableProfileCount();
 
        for (auto &p2p : p2p_policies) {
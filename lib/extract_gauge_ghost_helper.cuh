@@ -1,4 +1,5 @@
 #include <tune_quda.h>
+#include <host_launch.h>
 
 #pragma once
 
@@ -38,15 +39,16 @@ namespace quda {
      NB This routines is specialized to four dimensions
   */
   template <typename Float, int length, int nDim, typename Order, bool extract>
-  void extractGhost(ExtractGhostArg<Order,nDim> arg) {  
+  void extractGhost(Tunable &tunable, ExtractGhostArg<Order,nDim> &arg) {
     typedef typename mapper<Float>::type RegType;
 
-    for (int parity=0; parity<2; parity++) {
-
-      for (int dim=0; dim<nDim; dim++) {
+    // each (parity, dim) face is packed by a single thread since the ghost index is sequential
+    launchHost(tunable, 2*nDim, [&](int parity_dim) {
+	const int parity = parity_dim / nDim;
+	const int dim = parity_dim % nDim;
 
 	// for now we never inject unless we have partitioned in that dimension
-	if (!arg.commDim[dim] && !extract) continue;
+	if (!arg.commDim[dim] && !extract) return;
 
 	// linear index used for reading/writing into ghost buffer
 	int indexGhost = 0;
@@ -93,9 +95,7 @@ namespace quda {
 	} // d
 
 	assert(indexGhost == arg.faceVolumeCB[dim]);
-      } // dim
-
-    } // parity
+    });
 
   }
 
@@ -200,8 +200,8 @@ namespace quda {
   
     void apply(const cudaStream_t &stream) {
       if (location==QUDA_CPU_FIELD_LOCATION) {
-	if (extract) extractGhost<Float,length,nDim,Order,true>(arg);
-	else extractGhost<Float,length,nDim,Order,false>(arg);
+	if (extract) extractGhost<Float,length,nDim,Order,true>(*this, arg);
+	else extractGhost<Float,length,nDim,Order,false>(*this, arg);
       } else {
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	if (extract) {
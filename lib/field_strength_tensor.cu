@@ -1,6 +1,7 @@
 #include <quda_internal.h>
 #include <quda_matrix.h>
 #include <tune_quda.h>
+#include <host_launch.h>
 #include <gauge_field.h>
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
@@ -27,7 +28,7 @@ namespace quda {
   };
 
   template <int mu, int nu, typename Float, typename Arg>
-  __device__ __forceinline__ void computeFmunuCore(Arg &arg, int idx, int parity) {
+  __device__ __host__ __forceinline__ void computeFmunuCore(Arg &arg, int idx, int parity) {
 
       typedef Matrix<complex<Float>,3> Link;
 
@@ -185,24 +186,24 @@ namespace quda {
   }
   
   template<typename Float, typename Arg>
-  void computeFmunuCPU(Arg &arg) {
-    for (int parity=0; parity<2; parity++) {
-      for (int x_cb=0; x_cb<arg.threads; x_cb++) {
-	for (int mu=0; mu<4; mu++) {
-	  for (int nu=0; nu<mu; nu++) {
-	    int mu_nu = (mu*(mu-1))/2 + nu;
-	    switch(mu_nu) { // F[1,0], F[2,0], F[2,1], F[3,0], F[3,1], F[3,2]
-	    case 0: computeFmunuCore<1,0,Float>(arg, x_cb, parity); break;
-	    case 1: computeFmunuCore<2,0,Float>(arg, x_cb, parity); break;
-	    case 2: computeFmunuCore<2,1,Float>(arg, x_cb, parity); break;
-	    case 3: computeFmunuCore<3,0,Float>(arg, x_cb, parity); break;
-	    case 4: computeFmunuCore<3,1,Float>(arg, x_cb, parity); break;
-	    case 5: computeFmunuCore<3,2,Float>(arg, x_cb, parity); break;
-	    }
+  void computeFmunuCPU(Tunable &tunable, Arg &arg) {
+    launchHost(tunable, 2*arg.threads, [&](int i) {
+      const int x_cb = i % arg.threads;
+      const int parity = i / arg.threads;
+      for (int mu=0; mu<4; mu++) {
+	for (int nu=0; nu<mu; nu++) {
+	  int mu_nu = (mu*(mu-1))/2 + nu;
+	  switch(mu_nu) { // F[1,0], F[2,0], F[2,1], F[3,0], F[3,1], F[3,2]
+	  case 0: computeFmunuCore<1,0,Float>(arg, x_cb, parity); break;
+	  case 1: computeFmunuCore<2,0,Float>(arg, x_cb, parity); break;
+	  case 2: computeFmunuCore<2,1,Float>(arg, x_cb, parity); break;
+	  case 3: computeFmunuCore<3,0,Float>(arg, x_cb, parity); break;
+	  case 4: computeFmunuCore<3,1,Float>(arg, x_cb, parity); break;
+	  case 5: computeFmunuCore<3,2,Float>(arg, x_cb, parity); break;
 	  }
 	}
       }
-    }
+    });
   }
 
 
@@ -228,7 +229,7 @@ namespace quda {
           TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           computeFmunuKernel<Float><<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
         } else {
-          computeFmunuCPU<Float>(arg);
+          computeFmunuCPU<Float>(*this, arg);
         }
       }
 
@@ -272,6 +273,19 @@ namespace quda {
       } else {
 	errorQuda("Gauge field order %d not supported", gauge.Order());
       }
+    } else if (Fmunu.Order() == QUDA_MILC_GAUGE_ORDER && location == QUDA_CPU_FIELD_LOCATION) {
+      // host fields in one of the legacy orders (QDP order only holds four links per site)
+      typedef typename gauge_order_mapper<Float,QUDA_MILC_GAUGE_ORDER,3>::type F;
+
+      if (gauge.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_QDP_GAUGE_ORDER,3>::type G;
+	computeFmunu<Float>(F(Fmunu), G(gauge), Fmunu, gauge, location);
+      } else if (gauge.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_MILC_GAUGE_ORDER,3>::type G;
+	computeFmunu<Float>(F(Fmunu), G(gauge), Fmunu, gauge, location);
+      } else {
+	errorQuda("Gauge field order %d not supported", gauge.Order());
+      }
     } else {
       errorQuda("Fmunu field order %d not supported", Fmunu.Order());
     }
@@ -2,6 +2,7 @@
 #include <quda_matrix.h>
 #include <su3_project.cuh>
 #include <tune_quda.h>
+#include <host_launch.h>
 #include <gauge_field.h>
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
@@ -99,13 +100,8 @@ namespace quda {
   }
     
   template<typename Float, typename GaugeOr, typename GaugeDs>
-  __global__ void computeAPEStep(GaugeAPEArg<Float,GaugeOr,GaugeDs> arg){
-      
-    int idx = threadIdx.x + blockIdx.x*blockDim.x;
-    int parity = threadIdx.y + blockIdx.y*blockDim.y;
-    int dir = threadIdx.z + blockIdx.z*blockDim.z;
-    if (idx >= arg.threads) return;
-    if (dir >= 3) return;
+  __host__ __device__ void computeAPELink(GaugeAPEArg<Float,GaugeOr,GaugeDs> &arg, int idx, int parity, int dir){
+
     typedef complex<Float> Complex;
     typedef Matrix<complex<Float>,3> Link;
     
@@ -139,6 +135,28 @@ namespace quda {
       arg.dest(dir, linkIndexShift(x,dx,X), parity) = U;
     }
   }
+
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+  __global__ void computeAPEStep(GaugeAPEArg<Float,GaugeOr,GaugeDs> arg){
+
+    int idx = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y + blockIdx.y*blockDim.y;
+    int dir = threadIdx.z + blockIdx.z*blockDim.z;
+    if (idx >= arg.threads) return;
+    if (dir >= 3) return;
+    computeAPELink(arg, idx, parity, dir);
+  }
+
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+  void computeAPEStepCPU(Tunable &tunable, GaugeAPEArg<Float,GaugeOr,GaugeDs> &arg){
+    // only the spatial links are smeared
+    launchHost(tunable, 2*3*arg.threads, [&](int i) {
+      const int idx = i % arg.threads;
+      const int parity = (i / arg.threads) % 2;
+      const int dir = i / (2*arg.threads);
+      computeAPELink(arg, idx, parity, dir);
+    });
+  }
   
   template<typename Float, typename GaugeOr, typename GaugeDs>
   class GaugeAPE : TunableVectorYZ {
@@ -160,8 +178,7 @@ namespace quda {
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	computeAPEStep<<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
       } else {
-	errorQuda("CPU not supported yet\n");
-	//computeAPEStepCPU(arg);
+	computeAPEStepCPU(*this, arg);
       }
     }
     
@@ -185,7 +202,21 @@ namespace quda {
 
   template<typename Float>
     void APEStep(GaugeField &dataDs, const GaugeField& dataOr, Float alpha) {
-    
+
+    if (!dataDs.isNative()) {
+      // host fields in one of the legacy orders, which are stored without reconstruction
+      if (dataDs.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_QDP_GAUGE_ORDER,3>::type G;
+	APEStep(G(dataOr), G(dataDs), dataOr, alpha);
+      } else if (dataDs.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_MILC_GAUGE_ORDER,3>::type G;
+	APEStep(G(dataOr), G(dataDs), dataOr, alpha);
+      } else {
+	errorQuda("Order %d not supported", dataDs.Order());
+      }
+      return;
+    }
+
     if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
       typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type GDs;
 
@@ -249,10 +280,15 @@ namespace quda {
       errorQuda("Half precision not supported\n");
     }
 
-    if (!dataOr.isNative())
+    if (dataOr.Location() != dataDs.Location()) {
+      errorQuda("Origin and destination fields must be in the same location\n");
+    }
+
+    // host fields may also be in a legacy order, provided both fields share it
+    if (!dataOr.isNative() && (dataOr.Location() == QUDA_CUDA_FIELD_LOCATION || dataOr.Order() != dataDs.Order()))
       errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
 
-    if (!dataDs.isNative())
+    if (!dataDs.isNative() && (dataDs.Location() == QUDA_CUDA_FIELD_LOCATION || dataOr.Order() != dataDs.Order()))
       errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
 
     if (dataDs.Precision() == QUDA_SINGLE_PRECISION){
@@ -268,4 +304,18 @@ namespace quda {
 #endif
   }
 
+  void APEnStep(GaugeField &U, GaugeField &tmp, unsigned int nSteps, double alpha, bool no_comms_fill) {
+
+#ifdef GPU_GAUGE_TOOLS
+    // the workspace is reused for every step, so no field is allocated here
+    for (unsigned int i=0; i<nSteps; i++) {
+      tmp.copy(U);
+      tmp.exchangeExtendedGhost(tmp.R(), no_comms_fill);
+      APEStep(U, tmp, alpha);
+    }
+#else
+  errorQuda("Gauge tools are not build");
+#endif
+  }
+
 }
@@ -3,6 +3,7 @@
 #include <complex_quda.h>
 #include <index_helper.cuh>
 #include <tune_quda.h>
+#include <host_launch.h>
 
 /**
    This code has not been checked.  In particular, I suspect it is
@@ -112,15 +113,15 @@ namespace quda {
      Generic CPU staggered phase application
   */
   template <typename Float, QudaStaggeredPhase phaseType, typename Arg>
-  void gaugePhase(Arg &arg) {
-    for (int parity=0; parity<2; parity++) {
-      for (int indexCB=0; indexCB < arg.threads; indexCB++) {
-	gaugePhase<Float,phaseType,0>(indexCB, parity, arg);
-	gaugePhase<Float,phaseType,1>(indexCB, parity, arg);
-	gaugePhase<Float,phaseType,2>(indexCB, parity, arg);
-	gaugePhase<Float,phaseType,3>(indexCB, parity, arg);
-      }
-    }
+  void gaugePhase(Tunable &tunable, Arg &arg) {
+    launchHost(tunable, 2*arg.threads, [&](int i) {
+      const int indexCB = i % arg.threads;
+      const int parity = i / arg.threads;
+      gaugePhase<Float,phaseType,0>(indexCB, parity, arg);
+      gaugePhase<Float,phaseType,1>(indexCB, parity, arg);
+      gaugePhase<Float,phaseType,2>(indexCB, parity, arg);
+      gaugePhase<Float,phaseType,3>(indexCB, parity, arg);
+    });
   }
 
   /**
@@ -140,14 +141,14 @@ namespace quda {
   template <typename Float, QudaStaggeredPhase phaseType, typename Arg>
   class GaugePhase : TunableVectorY {
     Arg &arg;
-    const GaugeField &meta; // used for meta data only
+    GaugeField &meta; // used for meta data and for backing up host fields when tuning
 
   private:
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return arg.threads; }
 
   public:
-    GaugePhase(Arg &arg, const GaugeField &meta)
+    GaugePhase(Arg &arg, GaugeField &meta)
       : TunableVectorY(2), arg(arg), meta(meta) {
       writeAuxString("stride=%d,prec=%lu",arg.order.stride,sizeof(Float));
     }
@@ -159,7 +160,7 @@ namespace quda {
 	gaugePhaseKernel<Float, phaseType, Arg>
 	  <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
       } else {
-	gaugePhase<Float, phaseType, Arg>(arg);
+	gaugePhase<Float, phaseType, Arg>(*this, arg);
       }
     }
 
@@ -167,8 +168,8 @@ namespace quda {
       return TuneKey(meta.VolString(), typeid(*this).name(), aux);
     }
 
-    void preTune() { arg.order.save(); }
-    void postTune() { arg.order.load(); }
+    void preTune() { if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) arg.order.save(); else meta.backup(); }
+    void postTune() { if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) arg.order.load(); else meta.restore(); }
 
     long long flops() const { return 0; } 
     long long bytes() const { return 2 * arg.threads * 2 * arg.order.Bytes(); } // parity * e/o volume * i/o * vec size
@@ -176,7 +177,7 @@ namespace quda {
 
 
   template <typename Float, int Nc, typename Order>
-  void gaugePhase(Order order, const GaugeField &u) {
+  void gaugePhase(Order order, GaugeField &u) {
     if (u.StaggeredPhase() == QUDA_STAGGERED_PHASE_MILC) {
       GaugePhaseArg<Float,Nc,Order> arg(order, u);
       GaugePhase<Float,QUDA_STAGGERED_PHASE_MILC,
@@ -1,4 +1,5 @@
 #include <tune_quda.h>
+#include <host_launch.h>
 #include <gauge_field.h>
 #include <jitify_helper.cuh>
 #include <kernels/gauge_plaq.cuh>
@@ -38,7 +39,10 @@ namespace quda {
 	LAUNCH_KERNEL_LOCAL_PARITY(computePlaq, tp, stream, arg, Float, Gauge);
 #endif
       } else {
-	errorQuda("CPU not supported yet\n");
+	// the sums are deterministic, independent of the host launch parameters
+	arg.result_h[0] = launchHostReduce(*this, 2*arg.threads, make_double2(0.0,0.0),
+					   [&](int i) { return sitePlaquette<Float>(arg, i % arg.threads, i / arg.threads); },
+					   [](const double2 &a, const double2 &b) { return make_double2(a.x + b.x, a.y + b.y); });
       }
     }
 
@@ -59,6 +63,19 @@ namespace quda {
 
   template<typename Float>
   void plaquette(const GaugeField& data, double2 &plq, QudaFieldLocation location) {
+    if (!data.isNative() && data.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // host fields in one of the legacy orders
+      if (data.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_QDP_GAUGE_ORDER,3>::type Gauge;
+	plaquette<Float>(Gauge(data), data, plq, location);
+      } else if (data.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_MILC_GAUGE_ORDER,3>::type Gauge;
+	plaquette<Float>(Gauge(data), data, plq, location);
+      } else {
+	errorQuda("Order %d not supported", data.Order());
+      }
+      return;
+    }
     INSTANTIATE_RECONSTRUCT(plaquette<Float>, data, plq, location);
   }
 
@@ -2,6 +2,7 @@
 #include <quda_matrix.h>
 #include <su3_project.cuh>
 #include <tune_quda.h>
+#include <host_launch.h>
 #include <gauge_field.h>
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
@@ -99,13 +100,8 @@ namespace quda {
   }
   
   template<typename Float, typename GaugeOr, typename GaugeDs>
-    __global__ void computeSTOUTStep(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg){
+    __host__ __device__ void computeSTOUTLink(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> &arg, int idx, int parity, int dir){
 
-      int idx = threadIdx.x + blockIdx.x*blockDim.x;
-      int parity = threadIdx.y + blockIdx.y*blockDim.y;
-      int dir = threadIdx.z + blockIdx.z*blockDim.z;
-      if (idx >= arg.threads) return;
-      if (dir >= 3) return;
       typedef complex<Float> Complex;
       typedef Matrix<complex<Float>,3> Link;
 
@@ -200,6 +196,28 @@ namespace quda {
     }
   }
 
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+    __global__ void computeSTOUTStep(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg){
+
+      int idx = threadIdx.x + blockIdx.x*blockDim.x;
+      int parity = threadIdx.y + blockIdx.y*blockDim.y;
+      int dir = threadIdx.z + blockIdx.z*blockDim.z;
+      if (idx >= arg.threads) return;
+      if (dir >= 3) return;
+      computeSTOUTLink(arg, idx, parity, dir);
+  }
+
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+  void computeSTOUTStepCPU(Tunable &tunable, GaugeSTOUTArg<Float,GaugeOr,GaugeDs> &arg){
+    // only the spatial links are smeared
+    launchHost(tunable, 2*3*arg.threads, [&](int i) {
+      const int idx = i % arg.threads;
+      const int parity = (i / arg.threads) % 2;
+      const int dir = i / (2*arg.threads);
+      computeSTOUTLink(arg, idx, parity, dir);
+    });
+  }
+
   template<typename Float, typename GaugeOr, typename GaugeDs>
   class GaugeSTOUT : TunableVectorYZ {
       GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg;
@@ -220,8 +238,7 @@ namespace quda {
           TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           computeSTOUTStep<<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
         } else {
-          errorQuda("CPU not supported yet\n");
-          //computeSTOUTStepCPU(arg);
+          computeSTOUTStepCPU(*this, arg);
         }
       }
 
@@ -231,8 +248,9 @@ namespace quda {
         return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
       }
 
-      void preTune() { arg.dest.save(); } // defensive measure in case they alias
-      void postTune() { arg.dest.load(); }
+      // defensive measure in case they alias (host fields are not backed up)
+      void preTune() { if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) arg.dest.save(); }
+      void postTune() { if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) arg.dest.load(); }
 
       long long flops() const { return 3*(2+2*4)*198ll*arg.threads; } // just counts matrix multiplication
       long long bytes() const { return 3*((1+2*6)*arg.origin.Bytes()+arg.dest.Bytes())*arg.threads; }
@@ -249,6 +267,20 @@ namespace quda {
   template<typename Float>
   void STOUTStep(GaugeField &dataDs, const GaugeField& dataOr, Float rho) {
 
+    if (!dataDs.isNative()) {
+      // host fields in one of the legacy orders, which are stored without reconstruction
+      if (dataDs.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_QDP_GAUGE_ORDER,3>::type G;
+	STOUTStep(G(dataOr), G(dataDs), dataOr, rho);
+      } else if (dataDs.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_MILC_GAUGE_ORDER,3>::type G;
+	STOUTStep(G(dataOr), G(dataDs), dataOr, rho);
+      } else {
+	errorQuda("Order %d not supported", dataDs.Order());
+      }
+      return;
+    }
+
     if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
       typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type GDs;
 
@@ -312,10 +344,15 @@ namespace quda {
       errorQuda("Half precision not supported\n");
     }
 
-    if (!dataOr.isNative())
+    if (dataOr.Location() != dataDs.Location()) {
+      errorQuda("Origin and destination fields must be in the same location\n");
+    }
+
+    // host fields may also be in a legacy order, provided both fields share it
+    if (!dataOr.isNative() && (dataOr.Location() == QUDA_CUDA_FIELD_LOCATION || dataOr.Order() != dataDs.Order()))
       errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
 
-    if (!dataDs.isNative())
+    if (!dataDs.isNative() && (dataDs.Location() == QUDA_CUDA_FIELD_LOCATION || dataOr.Order() != dataDs.Order()))
       errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
 
     if (dataDs.Precision() == QUDA_SINGLE_PRECISION){
@@ -331,6 +368,20 @@ namespace quda {
 #endif
   }
 
+  void STOUTnStep(GaugeField &U, GaugeField &tmp, unsigned int nSteps, double rho, bool no_comms_fill) {
+
+#ifdef GPU_GAUGE_TOOLS
+    // the workspace is reused for every step, so no field is allocated here
+    for (unsigned int i=0; i<nSteps; i++) {
+      tmp.copy(U);
+      tmp.exchangeExtendedGhost(tmp.R(), no_comms_fill);
+      STOUTStep(U, tmp, rho);
+    }
+#else
+  errorQuda("Gauge tools are not build");
+#endif
+  }
+
 
   //------------------------//
   // Over-Improved routines //
@@ -598,13 +649,8 @@ namespace quda {
   }
   
   template<typename Float, typename GaugeOr, typename GaugeDs>
-    __global__ void computeOvrImpSTOUTStep(GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> arg){
+    __host__ __device__ void computeOvrImpSTOUTLink(GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> &arg, int idx, int parity, int dir){
 
-      int idx = threadIdx.x + blockIdx.x*blockDim.x;
-      int parity = threadIdx.y + blockIdx.y*blockDim.y;
-      int dir = threadIdx.z + blockIdx.z*blockDim.z;
-      if (idx >= arg.threads) return;
-      //if (dir >= 3) return;
       typedef complex<Float> Complex;
       typedef Matrix<complex<Float>,3> Link;
 
@@ -702,6 +748,28 @@ namespace quda {
     }
   }
 
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+    __global__ void computeOvrImpSTOUTStep(GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> arg){
+
+      int idx = threadIdx.x + blockIdx.x*blockDim.x;
+      int parity = threadIdx.y + blockIdx.y*blockDim.y;
+      int dir = threadIdx.z + blockIdx.z*blockDim.z;
+      if (idx >= arg.threads) return;
+      //if (dir >= 3) return;
+      computeOvrImpSTOUTLink(arg, idx, parity, dir);
+  }
+
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+  void computeOvrImpSTOUTStepCPU(Tunable &tunable, GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> &arg){
+    // as on the device, only the spatial links are smeared
+    launchHost(tunable, 2*3*arg.threads, [&](int i) {
+      const int idx = i % arg.threads;
+      const int parity = (i / arg.threads) % 2;
+      const int dir = i / (2*arg.threads);
+      computeOvrImpSTOUTLink(arg, idx, parity, dir);
+    });
+  }
+
   
   template<typename Float, typename GaugeOr, typename GaugeDs>
     class GaugeOvrImpSTOUT : TunableVectorYZ {
@@ -723,8 +791,7 @@ namespace quda {
           TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           computeOvrImpSTOUTStep<<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
         } else {
-          errorQuda("CPU not supported yet\n");
-          //computeOvrImpSTOUTStepCPU(arg);
+          computeOvrImpSTOUTStepCPU(*this, arg);
         }
       }
 
@@ -734,8 +801,9 @@ namespace quda {
         return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
       }
 
-    void preTune() { arg.dest.save(); } // defensive measure in case they alias
-    void postTune() { arg.dest.load(); }
+    // defensive measure in case they alias (host fields are not backed up)
+    void preTune() { if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) arg.dest.save(); }
+    void postTune() { if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) arg.dest.load(); }
 
     long long flops() const { return 4*(18+2+2*4)*198ll*arg.threads; } // just counts matrix multiplication
     long long bytes() const { return 4*((1+2*12)*arg.origin.Bytes()+arg.dest.Bytes())*arg.threads; }
@@ -753,7 +821,21 @@ namespace quda {
 
   template<typename Float>
   void OvrImpSTOUTStep(GaugeField &dataDs, const GaugeField& dataOr, Float rho, Float epsilon) {
-    
+
+    if (!dataDs.isNative()) {
+      // host fields in one of the legacy orders, which are stored without reconstruction
+      if (dataDs.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_QDP_GAUGE_ORDER,3>::type G;
+	OvrImpSTOUTStep(G(dataOr), G(dataDs), dataOr, rho, epsilon);
+      } else if (dataDs.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge_order_mapper<Float,QUDA_MILC_GAUGE_ORDER,3>::type G;
+	OvrImpSTOUTStep(G(dataOr), G(dataDs), dataOr, rho, epsilon);
+      } else {
+	errorQuda("Order %d not supported", dataDs.Order());
+      }
+      return;
+    }
+
     if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
       typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type GDs;
 
@@ -816,10 +898,15 @@ namespace quda {
       errorQuda("Half precision not supported\n");
     }
 
-    if (!dataOr.isNative())
+    if (dataOr.Location() != dataDs.Location()) {
+      errorQuda("Origin and destination fields must be in the same location\n");
+    }
+
+    // host fields may also be in a legacy order, provided both fields share it
+    if (!dataOr.isNative() && (dataOr.Location() == QUDA_CUDA_FIELD_LOCATION || dataOr.Order() != dataDs.Order()))
       errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
 
-    if (!dataDs.isNative())
+    if (!dataDs.isNative() && (dataDs.Location() == QUDA_CUDA_FIELD_LOCATION || dataOr.Order() != dataDs.Order()))
       errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
 
     if (dataDs.Precision() == QUDA_SINGLE_PRECISION){
@@ -832,6 +919,20 @@ namespace quda {
     return;
 #else
   errorQuda("Gauge tools are not build");
+#endif
+  }
+
+  void OvrImpSTOUTnStep(GaugeField &U, GaugeField &tmp, unsigned int nSteps, double rho, double epsilon, bool no_comms_fill) {
+
+#ifdef GPU_GAUGE_TOOLS
+    // the workspace is reused for every step, so no field is allocated here
+    for (unsigned int i=0; i<nSteps; i++) {
+      tmp.copy(U);
+      tmp.exchangeExtendedGhost(tmp.R(), no_comms_fill);
+      OvrImpSTOUTStep(U, tmp, rho, epsilon);
+    }
+#else
+  errorQuda("Gauge tools are not build");
 #endif
   }
 }
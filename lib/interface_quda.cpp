@@ -1441,14 +1441,22 @@ void endQuda(void)
   // flush any outstanding force monitoring (if enabled)
   flushForceMonitor();
 
+  printMallocProfile();
+
   initialized = false;
 
+  // the rank is no longer available once comms have been finalized
+  const int rank = comm_rank();
+
   comm_finalize();
   comms_initialized = false;
 
   profileEnd.TPSTOP(QUDA_PROFILE_TOTAL);
   profileInit2End.TPSTOP(QUDA_PROFILE_TOTAL);
 
+  // dump the trace of the lifetime of the library (if enabled)
+  TimeProfile::WriteTrace(rank);
+
   // print out the profile information of the lifetime of the library
   if (getVerbosity() >= QUDA_SUMMARIZE) {
     profileInit.Print();
@@ -2779,6 +2787,7 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
   param->secs = 0;
   param->gflops = 0;
   param->iter = 0;
+  param->history_length = 0;
 
   Dirac *d = nullptr;
   Dirac *dSloppy = nullptr;
@@ -3186,6 +3195,7 @@ void invertMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param)
   param->secs = 0;
   param->gflops = 0;
   param->iter = 0;
+  param->history_length = 0;
 
   Dirac *d = nullptr;
   Dirac *dSloppy = nullptr;
@@ -3561,6 +3571,7 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
   param->secs = 0;
   param->gflops = 0;
   param->iter = 0;
+  param->history_length = 0;
 
   for (int i=0; i<param->num_offset-1; i++) {
     for (int j=i+1; j<param->num_offset; j++) {
@@ -5493,11 +5504,7 @@ void performAPEnStep(unsigned int nSteps, double alpha)
     printfQuda("Plaquette after 0 APE steps: %le %le %le\n", plq.x, plq.y, plq.z);
   }
 
-  for (unsigned int i=0; i<nSteps; i++) {
-    cudaGaugeTemp->copy(*gaugeSmeared);
-    cudaGaugeTemp->exchangeExtendedGhost(R,profileAPE,redundant_comms);
-    APEStep(*gaugeSmeared, *cudaGaugeTemp, alpha);
-  }
+  APEnStep(*gaugeSmeared, *cudaGaugeTemp, nSteps, alpha, redundant_comms);
 
   delete cudaGaugeTemp;
 
@@ -5528,11 +5535,7 @@ void performSTOUTnStep(unsigned int nSteps, double rho)
     printfQuda("Plaquette after 0 STOUT steps: %le %le %le\n", plq.x, plq.y, plq.z);
   }
 
-  for (unsigned int i=0; i<nSteps; i++) {
-    cudaGaugeTemp->copy(*gaugeSmeared);
-    cudaGaugeTemp->exchangeExtendedGhost(R,profileSTOUT,redundant_comms);
-    STOUTStep(*gaugeSmeared, *cudaGaugeTemp, rho);
-  }
+  STOUTnStep(*gaugeSmeared, *cudaGaugeTemp, nSteps, rho, redundant_comms);
 
   delete cudaGaugeTemp;
 
@@ -5563,11 +5566,7 @@ void performSTOUTnStep(unsigned int nSteps, double rho)
     printfQuda("Plaquette after 0 OvrImpSTOUT steps: %le %le %le\n", plq.x, plq.y, plq.z);
   }
 
-  for (unsigned int i=0; i<nSteps; i++) {
-    cudaGaugeTemp->copy(*gaugeSmeared);
-    cudaGaugeTemp->exchangeExtendedGhost(R,profileOvrImpSTOUT,redundant_comms);
-    OvrImpSTOUTStep(*gaugeSmeared, *cudaGaugeTemp, rho, epsilon);
-  }
+  OvrImpSTOUTnStep(*gaugeSmeared, *cudaGaugeTemp, nSteps, rho, epsilon, redundant_comms);
 
   delete cudaGaugeTemp;
 
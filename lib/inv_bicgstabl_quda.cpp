@@ -656,6 +656,7 @@ namespace quda {
         mat(r_full, y, x); // r[0] = Ax
         
         r2 = blas::xmyNorm(b, r_full); // r = b - Ax, return norm.
+        RecordTrueResidual(solver_name.c_str(), k + nKrylov, r2, b2, heavy_quark_res);
         
         sigma[0] = r2;
         
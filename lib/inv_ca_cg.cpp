@@ -339,6 +339,7 @@ namespace quda {
 	mat(r_, x, tmp, tmp2);
 	r2 = blas::xmyNorm(b, r_);
 	if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(x, r_).z);
+	RecordTrueResidual("CA-CG", total_iter, r2, b2, heavy_quark_res);
 
         // break-out check if we have reached the limit of the precision
 	if (r2 > r2_old) {
@@ -357,7 +358,7 @@ namespace quda {
 	if ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) ) {
 	  restart++; // restarting if residual is still too great
 
-	  PrintStats("CA-CG (restart)", restart, r2, b2, heavy_quark_res);
+	  PrintStats("CA-CG (restart)", restart, r2, b2, heavy_quark_res, false);
           blas::copy(*p[0], r_);
 
 	  r2_old = r2;
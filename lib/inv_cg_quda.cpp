@@ -574,6 +574,8 @@ namespace quda {
         // calculate new reliable HQ resididual
         if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(y, r).z);
 
+        RecordTrueResidual("CG", k, r2, b2, heavy_quark_res);
+
         // break-out check if we have reached the limit of the precision
         if (sqrt(r2) > r0Norm && updateX) { // reuse r0Norm for this
           resIncrease++;
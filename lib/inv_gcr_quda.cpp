@@ -407,6 +407,7 @@ namespace quda {
 	r2 = blas::xmyNorm(b, r);  
 
 	if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(x, r).z);
+	RecordTrueResidual("GCR", total_iter, r2, b2, heavy_quark_res);
 
 	// break-out check if we have reached the limit of the precision
 	if (r2 > r2_old) {
@@ -428,7 +429,7 @@ namespace quda {
 	if ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) ) {
 	  restart++; // restarting if residual is still too great
 
-	  PrintStats("GCR (restart)", restart, r2, b2, heavy_quark_res);
+	  PrintStats("GCR (restart)", restart, r2, b2, heavy_quark_res, false);
 	  blas::copy(rSloppy, r);
 	  blas::zero(ySloppy);
 
@@ -323,6 +323,7 @@ namespace quda {
     profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
     profile.TPSTART(QUDA_PROFILE_COMPUTE);
 
+    param.history.record("MultiShift CG", k, r2[0], b2, 0.0);
     if (getVerbosity() >= QUDA_VERBOSE) 
       printfQuda("MultiShift CG: %d iterations, <r,r> = %e, |r|/|b| = %e\n", k, r2[0], sqrt(r2[0]/b2));
     
@@ -393,6 +394,7 @@ namespace quda {
 	if (r->Nspin()==4) blas::axpy(offset[0], *y[0], *r);
 
 	r2[0] = blas::xmyNorm(b, *r);
+	param.history.record("MultiShift CG", k + 1, r2[0], b2, 0.0, r2[0]);
 	for (int j=1; j<num_offset_now; j++) r2[j] = zeta[j] * zeta[j] * r2[0];
 	for (int j=0; j<num_offset_now; j++) blas::zero(*x_sloppy[j]);
 
@@ -477,6 +479,7 @@ namespace quda {
       
       k++;
 
+      param.history.record("MultiShift CG", k, r2[0], b2, 0.0);
       if (getVerbosity() >= QUDA_VERBOSE) 
 	printfQuda("MultiShift CG: %d iterations, <r,r> = %e, |r|/|b| = %e\n", k, r2[0], sqrt(r2[0]/b2));
     }
@@ -529,6 +532,13 @@ namespace quda {
         }
       }
 
+      if (std::isinf(param.true_res_offset[0])) {
+        param.history.record("MultiShift CG", k, r2[0], b2, 0.0);
+      } else {
+        double true_r2 = param.true_res_offset[0] * param.true_res_offset[0] * b2;
+        param.history.record("MultiShift CG", k, r2[0], b2, param.true_res_hq_offset[0], true_r2);
+      }
+
       if (getVerbosity() >= QUDA_SUMMARIZE) {
         printfQuda("MultiShift CG: Converged after %d iterations\n", k);
         for (int i = 0; i < num_offset; i++) {
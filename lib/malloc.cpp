@@ -2,9 +2,17 @@
 #include <cstdio>
 #include <string>
 #include <map>
+#include <tuple>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <mutex>
 #include <unistd.h> // for getpagesize()
 #include <execinfo.h> // for backtrace
 #include <quda_internal.h>
+#include <comm_quda.h>
 
 #ifdef USE_QDPJIT
 #include "qdp_quda.h"
@@ -96,8 +104,112 @@ namespace quda {
   }
 
 
+  /**
+     Opt-in allocation profiler, enabled by setting
+     QUDA_ENABLE_MALLOC_PROFILE=1.  Allocations are aggregated per call
+     site, including those served by the memory pools, and a summary
+     is written at endQuda.  When disabled the only cost is a test of
+     malloc_profile in each allocation and free.  The profiler state
+     is guarded by profile_mutex, since pool allocations may be made
+     from several host threads.
+  */
+  static const bool malloc_profile = getenv("QUDA_ENABLE_MALLOC_PROFILE") && strcmp(getenv("QUDA_ENABLE_MALLOC_PROFILE"), "0");
+
+  /** profiler categories: the AllocTypes followed by the pools */
+  enum { POOL_DEVICE = N_ALLOC_TYPE, POOL_PINNED, N_PROFILE_TYPE };
+  static const char *profile_type_str[] = {"Device", "Device Pinned", "Host", "Pinned", "Mapped", "Pool Device", "Pool Pinned"};
+
+  /** allocations freed within this time (seconds) count as short lived */
+  static constexpr double short_lived_time = 1e-2;
+
+  /** call sites with at least this many short-lived allocations are flagged as churning */
+  static constexpr size_t churn_count = 32;
+
+  struct AllocSite {
+    size_t count = 0;       // number of allocations
+    size_t frees = 0;       // number of frees
+    size_t bytes = 0;       // total bytes allocated
+    size_t live = 0;        // bytes presently allocated
+    size_t max_live = 0;    // maximum bytes allocated at once
+    size_t peak = 0;        // bytes allocated at the time of the overall peak, valid if epoch == profile_peak_epoch
+    size_t epoch = 0;       // value of profile_peak_epoch when live last changed
+    size_t short_lived = 0; // number of allocations freed within short_lived_time
+    double lifetime = 0.0;  // summed lifetime of the freed allocations
+  };
+
+  struct AllocRecord {
+    AllocSite *site;
+    size_t bytes;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  typedef std::tuple<int, std::string, std::string, int> site_key;
+  static std::map<site_key, AllocSite> alloc_sites;
+  static std::map<std::pair<int, void *>, AllocRecord> alloc_records;
+  static size_t profile_live_bytes = 0;
+  static size_t profile_peak_bytes = 0;
+  static size_t profile_peak_epoch = 0; // number of times a new overall peak has been reached
+  static std::mutex profile_mutex;
+
+  /**
+     The per-site bytes at the overall peak are recorded lazily: a site
+     whose live bytes have not changed since the last peak still holds
+     its value at that peak, so it is only snapshotted before its next
+     change (or when the profile is printed), rather than every site
+     being updated each time a new peak is reached.
+  */
+  static inline size_t site_peak(const AllocSite &site)
+  {
+    return site.epoch == profile_peak_epoch ? site.peak : site.live;
+  }
+
+  static inline void sync_peak(AllocSite &site)
+  {
+    site.peak = site_peak(site);
+    site.epoch = profile_peak_epoch;
+  }
+
+  static void profile_malloc(int type, const char *func, const char *file, int line, size_t bytes, void *ptr)
+  {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    AllocSite &site = alloc_sites[site_key(type, func, file, line)];
+    sync_peak(site);
+    site.count++;
+    site.bytes += bytes;
+    site.live += bytes;
+    site.max_live = std::max(site.live, site.max_live);
+    alloc_records[std::make_pair(type, ptr)] = {&site, bytes, std::chrono::steady_clock::now()};
+
+    // pool allocations are carved out of memory already counted against the underlying type
+    if (type < N_ALLOC_TYPE) {
+      profile_live_bytes += bytes;
+      if (profile_live_bytes > profile_peak_bytes) {
+        profile_peak_bytes = profile_live_bytes;
+        profile_peak_epoch++;
+        sync_peak(site);
+      }
+    }
+  }
+
+  static void profile_free(int type, void *ptr)
+  {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    auto record = alloc_records.find(std::make_pair(type, ptr));
+    if (record == alloc_records.end()) return; // allocated before profiling began
+    AllocRecord &r = record->second;
+    const double lifetime = std::chrono::duration<double>(std::chrono::steady_clock::now() - r.start).count();
+    sync_peak(*r.site);
+    r.site->frees++;
+    r.site->live -= r.bytes;
+    r.site->lifetime += lifetime;
+    if (lifetime < short_lived_time) r.site->short_lived++;
+    if (type < N_ALLOC_TYPE) profile_live_bytes -= r.bytes;
+    alloc_records.erase(record);
+  }
+
   static void track_malloc(const AllocType &type, const MemAlloc &a, void *ptr)
   {
+    if (malloc_profile) profile_malloc(type, a.func.c_str(), a.file.c_str(), a.line, a.base_size, ptr);
     total_bytes[type] += a.base_size;
     if (total_bytes[type] > max_total_bytes[type]) {
       max_total_bytes[type] = total_bytes[type];
@@ -120,6 +232,7 @@ namespace quda {
 
   static void track_free(const AllocType &type, void *ptr)
   {
+    if (malloc_profile) profile_free(type, ptr);
     size_t size = alloc[type][ptr].base_size;
     total_bytes[type] -= size;
     if (type != DEVICE && type != DEVICE_PINNED) {
@@ -412,6 +525,7 @@ namespace quda {
     printfQuda("Pinned device memory used = %.1f MB\n", max_total_bytes[DEVICE_PINNED] / (double)(1<<20));
     printfQuda("Page-locked host memory used = %.1f MB\n", max_total_pinned_bytes / (double)(1<<20));
     printfQuda("Total host memory used >= %.1f MB\n", max_total_host_bytes / (double)(1<<20));
+    pool::print_stats();
   }
 
 
@@ -430,6 +544,84 @@ namespace quda {
     }
   }
 
+  void printMallocProfile()
+  {
+    if (!malloc_profile) return;
+
+    std::vector<std::pair<site_key, AllocSite>> sites;
+    size_t peak_bytes;
+    {
+      std::lock_guard<std::mutex> lock(profile_mutex);
+      for (auto &entry : alloc_sites) sync_peak(entry.second);
+      sites.assign(alloc_sites.begin(), alloc_sites.end());
+      peak_bytes = profile_peak_bytes;
+    }
+    std::sort(sites.begin(), sites.end(),
+              [](const std::pair<site_key, AllocSite> &a, const std::pair<site_key, AllocSite> &b) {
+                return a.second.bytes > b.second.bytes;
+              });
+
+    const double MB = static_cast<double>(1 << 20);
+    auto mean_lifetime = [](const AllocSite &site) { return site.frees ? 1e3 * site.lifetime / site.frees : 0.0; };
+
+    // full profile of this process
+    char *path = getenv("QUDA_RESOURCE_PATH");
+    if (path) {
+      std::string profile_path = std::string(path) + "/malloc_profile_" + std::to_string(comm_rank()) + ".tsv";
+      std::ofstream profile_file(profile_path.c_str());
+      profile_file << "type\tfunc\tfile\tline\tcount\tfrees\tbytes\tmax_live\tpeak\tlive\tshort_lived\tmean_lifetime_ms" << std::endl;
+      for (auto &entry : sites) {
+        const AllocSite &site = entry.second;
+        profile_file << profile_type_str[std::get<0>(entry.first)] << "\t" << std::get<1>(entry.first) << "\t"
+                     << std::get<2>(entry.first) << "\t" << std::get<3>(entry.first) << "\t" << site.count << "\t"
+                     << site.frees << "\t" << site.bytes << "\t" << site.max_live << "\t" << site.peak << "\t"
+                     << site.live << "\t" << site.short_lived << "\t" << mean_lifetime(site) << std::endl;
+      }
+      profile_file.close();
+      printfQuda("Allocation profile written to %s\n", profile_path.c_str());
+    }
+
+    printfQuda("\nAllocation profile: %d call sites, peak of %.1f MB allocated\n", static_cast<int>(sites.size()),
+               peak_bytes / MB);
+    printfQuda("Type          Count     Total MB   Max MB     Peak MB    Lifetime (ms) Location\n");
+    printfQuda("----------------------------------------------------------------------------------------\n");
+    const int max_sites = getVerbosity() >= QUDA_VERBOSE ? static_cast<int>(sites.size()) : 20;
+    for (int i = 0; i < std::min(max_sites, static_cast<int>(sites.size())); i++) {
+      const AllocSite &site = sites[i].second;
+      printfQuda("%-13s %-9zu %-10.1f %-10.1f %-10.1f %-13.3f %s(), %s:%d\n", profile_type_str[std::get<0>(sites[i].first)],
+                 site.count, site.bytes / MB, site.max_live / MB, site.peak / MB, mean_lifetime(site),
+                 std::get<1>(sites[i].first).c_str(), std::get<2>(sites[i].first).c_str(), std::get<3>(sites[i].first));
+    }
+
+    bool churn = false;
+    for (auto &entry : sites) {
+      const AllocSite &site = entry.second;
+      if (site.short_lived < churn_count || 2 * site.short_lived < site.count) continue;
+      if (!churn) {
+        printfQuda("\nThe following call sites repeatedly allocate and free within %.0f ms, and are candidates for hoisting out of loops:\n",
+                   1e3 * short_lived_time);
+        churn = true;
+      }
+      printfQuda("  %s(), %s:%d: %zu of %zu allocations (%s) short lived, mean lifetime %.3f ms\n",
+                 std::get<1>(entry.first).c_str(), std::get<2>(entry.first).c_str(), std::get<3>(entry.first),
+                 site.short_lived, site.count, profile_type_str[std::get<0>(entry.first)], mean_lifetime(site));
+    }
+
+    bool leak = false;
+    for (auto &entry : sites) {
+      const AllocSite &site = entry.second;
+      if (site.live == 0) continue;
+      if (!leak) {
+        printfQuda("\nThe following call sites still have memory allocated:\n");
+        leak = true;
+      }
+      printfQuda("  %s(), %s:%d: %.3f MB in %zu allocations (%s)\n", std::get<1>(entry.first).c_str(),
+                 std::get<2>(entry.first).c_str(), std::get<3>(entry.first), site.live / MB, site.count - site.frees,
+                 profile_type_str[std::get<0>(entry.first)]);
+    }
+    printfQuda("\n");
+  }
+
   QudaFieldLocation get_pointer_location(const void *ptr) {
 
     CUpointer_attribute attribute[] = { CU_POINTER_ATTRIBUTE_MEMORY_TYPE };
@@ -460,25 +652,264 @@ namespace quda {
 
   namespace pool {
 
-    /** Cache of inactive pinned-memory allocations.  We cache pinned
-	memory allocations so that fields can reuse these with minimal
-	overhead.*/
-    static std::multimap<size_t, void *> pinnedCache;
+    /**
+       @brief Size-class arena used by the pool allocators.  Requests
+       are rounded up to a size class (four classes per power of two,
+       so at most a quarter of a block is wasted) and carved out of
+       chunks obtained from the backend allocator.  Freed blocks are
+       coalesced with their free neighbours in the same chunk, so
+       memory released by one field can be reused by a differently
+       sized one.  Chunks that are entirely free are returned to the
+       backend when the cached bytes exceed the high-water mark, or
+       when flushed.  The arena knows nothing about the type of memory
+       it is managing, so the same logic serves device and pinned
+       memory.
+    */
+    class Arena {
+
+      typedef void *(*backend_malloc_t)(const char *, const char *, int, size_t);
+      typedef void (*backend_free_t)(const char *, const char *, int, void *);
+
+      /** granularity (and hence alignment relative to the chunk) of all blocks */
+      static constexpr size_t quantum = 4096;
+
+      /** smallest chunk requested from the backend, so that small blocks share chunks */
+      static constexpr size_t min_chunk = 2 * 1024 * 1024;
+
+      struct Block {
+        size_t size;      // size of the block
+        size_t requested; // size requested by the caller (if in use)
+        char *chunk;      // base of the chunk this block belongs to
+        bool free;
+      };
+
+      const char *label;
+      const int profile_type;
+      backend_malloc_t backend_malloc;
+      backend_free_t backend_free;
+
+      std::map<char *, Block> blocks;            // all blocks, ordered by address
+      std::multimap<size_t, char *> free_blocks; // free blocks, ordered by size
+      std::map<char *, size_t> chunks;           // chunks obtained from the backend
+
+      size_t high_water; // cached bytes above which free chunks are released (0 = no limit)
+
+      size_t requests;        // number of allocations
+      size_t hits;            // allocations served without calling the backend
+      size_t chunk_allocs;    // chunks obtained from the backend
+      size_t chunk_frees;     // chunks returned to the backend
+      size_t bytes_reserved;  // bytes held from the backend
+      size_t bytes_in_use;    // bytes in blocks handed out
+      size_t bytes_requested; // bytes requested for the blocks handed out
+      size_t max_bytes_reserved;
+      size_t max_bytes_in_use;
+
+      static size_t size_class(size_t size)
+      {
+        // zero-byte requests still get a distinct block
+        size = ((std::max<size_t>(size, 1) + quantum - 1) / quantum) * quantum;
+        if (size <= 4 * quantum) return size;
+        size_t step = 1;
+        while (step <= size) step <<= 1;
+        step >>= 3; // a quarter of the largest power of two not exceeding size
+        return ((size + step - 1) / step) * step;
+      }
 
-    /** Sizes of active pinned-memory allocations.  For convenience,
-	we keep track of the sizes of active allocations (i.e., those not
-	in the cache). */
-    static std::map<void *, size_t> pinnedSize;
+      void erase_free(char *ptr, size_t size)
+      {
+        auto range = free_blocks.equal_range(size);
+        for (auto it = range.first; it != range.second; it++) {
+          if (it->second == ptr) {
+            free_blocks.erase(it);
+            return;
+          }
+        }
+        errorQuda("%s pool: free block %p of size %zu not found", label, ptr, size);
+      }
 
-    /** Cache of inactive device-memory allocations.  We cache pinned
-	memory allocations so that fields can reuse these with minimal
-	overhead.*/
-    static std::multimap<size_t, void *> deviceCache;
+      size_t bytes_cached() const { return bytes_reserved - bytes_in_use; }
+
+      /**
+         @brief Return entirely free chunks to the backend, largest
+         first, until the cached bytes do not exceed the given limit
+         or no further chunks can be released.
+      */
+      void trim(size_t limit)
+      {
+        auto it = free_blocks.end();
+        while (bytes_cached() > limit && it != free_blocks.begin()) {
+          --it;
+          char *ptr = it->second;
+          Block &b = blocks[ptr];
+          if (ptr != b.chunk || b.size != chunks[ptr]) continue; // only part of a chunk is free
+
+          it = free_blocks.erase(it);
+          release_chunk(ptr, b.size);
+        }
+      }
 
-    /** Sizes of active device-memory allocations.  For convenience,
-	we keep track of the sizes of active allocations (i.e., those not
-	in the cache). */
-    static std::map<void *, size_t> deviceSize;
+      void release_chunk(char *ptr, size_t size)
+      {
+        blocks.erase(ptr);
+        chunks.erase(ptr);
+        bytes_reserved -= size;
+        chunk_frees++;
+        backend_free(__func__, file_name(__FILE__), __LINE__, ptr);
+      }
+
+    public:
+      Arena(const char *label, int profile_type, backend_malloc_t backend_malloc, backend_free_t backend_free) :
+        label(label),
+        profile_type(profile_type),
+        backend_malloc(backend_malloc),
+        backend_free(backend_free),
+        high_water(0),
+        requests(0),
+        hits(0),
+        chunk_allocs(0),
+        chunk_frees(0),
+        bytes_reserved(0),
+        bytes_in_use(0),
+        bytes_requested(0),
+        max_bytes_reserved(0),
+        max_bytes_in_use(0)
+      {
+      }
+
+      void set_high_water(size_t bytes) { high_water = bytes; }
+
+      void *allocate(const char *func, const char *file, int line, size_t nbytes)
+      {
+        const size_t size = size_class(nbytes);
+        requests++;
+
+        auto it = free_blocks.lower_bound(size);
+        if (it == free_blocks.end()) {
+          // nothing cached is large enough: release the smallest entirely free chunk, since it cannot
+          // serve this request, and anything above the high-water mark before growing the arena
+          for (auto f = free_blocks.begin(); f != free_blocks.end(); f++) {
+            Block &b = blocks[f->second];
+            if (f->second == b.chunk && b.size == chunks[b.chunk]) {
+              char *ptr = f->second;
+              size_t chunk_size = b.size;
+              free_blocks.erase(f);
+              release_chunk(ptr, chunk_size);
+              break;
+            }
+          }
+          if (high_water) trim(high_water > size ? high_water - size : 0);
+
+          const size_t chunk_size = std::max(size, min_chunk);
+          char *chunk = static_cast<char *>(backend_malloc(func, file, line, chunk_size));
+          chunks[chunk] = chunk_size;
+          blocks[chunk] = {chunk_size, 0, chunk, true};
+          it = free_blocks.insert(std::make_pair(chunk_size, chunk));
+          bytes_reserved += chunk_size;
+          max_bytes_reserved = std::max(bytes_reserved, max_bytes_reserved);
+          chunk_allocs++;
+        } else {
+          hits++;
+        }
+
+        char *ptr = it->second;
+        free_blocks.erase(it);
+        Block &b = blocks[ptr];
+
+        if (b.size > size) { // split off the remainder
+          blocks[ptr + size] = {b.size - size, 0, b.chunk, true};
+          free_blocks.insert(std::make_pair(b.size - size, ptr + size));
+          b.size = size;
+        }
+
+        b.free = false;
+        b.requested = nbytes;
+        bytes_in_use += b.size;
+        bytes_requested += nbytes;
+        max_bytes_in_use = std::max(bytes_in_use, max_bytes_in_use);
+        if (malloc_profile) profile_malloc(profile_type, func, file, line, nbytes, ptr);
+        return ptr;
+      }
+
+      void free(const char *func, const char *file, int line, void *ptr_)
+      {
+        char *ptr = static_cast<char *>(ptr_);
+        auto it = blocks.find(ptr);
+        if (it == blocks.end() || it->second.free) {
+          printfQuda("ERROR: Attempt to free invalid %s pool pointer (%s:%d in %s())\n", label, file, line, func);
+          errorQuda("Aborting");
+        }
+
+        if (malloc_profile) profile_free(profile_type, ptr);
+        Block &b = it->second;
+        b.free = true;
+        bytes_in_use -= b.size;
+        bytes_requested -= b.requested;
+
+        // coalesce with the following block
+        auto next = std::next(it);
+        if (next != blocks.end() && next->second.free && next->second.chunk == b.chunk) {
+          erase_free(next->first, next->second.size);
+          b.size += next->second.size;
+          blocks.erase(next);
+        }
+
+        // coalesce with the preceding block
+        if (it != blocks.begin()) {
+          auto prev = std::prev(it);
+          if (prev->second.free && prev->second.chunk == b.chunk) {
+            erase_free(prev->first, prev->second.size);
+            prev->second.size += b.size;
+            blocks.erase(it);
+            it = prev;
+          }
+        }
+
+        free_blocks.insert(std::make_pair(it->second.size, it->first));
+
+        if (high_water && bytes_cached() > high_water) trim(high_water);
+      }
+
+      /**
+         @brief Return all entirely free chunks to the backend
+      */
+      void flush() { trim(0); }
+
+      void print_stats() const
+      {
+        if (requests == 0) return;
+        const size_t cached = bytes_cached();
+        const size_t largest_free = free_blocks.empty() ? 0 : free_blocks.rbegin()->first;
+        const double MB = static_cast<double>(1 << 20);
+
+        printfQuda("%s memory pool: %zu allocations, hit rate = %.1f%%, %zu chunks allocated, %zu released\n", label,
+                   requests, 100.0 * hits / requests, chunk_allocs, chunk_frees);
+        printfQuda("%s memory pool: reserved = %.1f MB (peak %.1f MB), in use = %.1f MB (peak %.1f MB), cached = %.1f MB\n",
+                   label, bytes_reserved / MB, max_bytes_reserved / MB, bytes_in_use / MB, max_bytes_in_use / MB, cached / MB);
+        printfQuda("%s memory pool: fragmentation = %.1f%% (largest free block %.1f MB), size-class padding = %.1f MB\n",
+                   label, cached ? 100.0 * (1.0 - static_cast<double>(largest_free) / cached) : 0.0, largest_free / MB,
+                   (bytes_in_use - bytes_requested) / MB);
+      }
+    };
+
+    static void host_free_backend(const char *func, const char *file, int line, void *ptr)
+    {
+      quda::host_free_(func, file, line, ptr);
+    }
+
+    static void device_free_backend(const char *func, const char *file, int line, void *ptr)
+    {
+      quda::device_free_(func, file, line, ptr);
+    }
+
+    /** Arena of pinned-memory allocations.  We cache pinned memory
+        allocations so that fields can reuse these with minimal
+        overhead.*/
+    static Arena pinnedArena("Pinned", POOL_PINNED, quda::pinned_malloc_, host_free_backend);
+
+    /** Arena of device-memory allocations.  We cache device memory
+        allocations so that fields can reuse these with minimal
+        overhead.*/
+    static Arena deviceArena("Device", POOL_DEVICE, quda::device_malloc_, device_free_backend);
 
     static bool pool_init = false;
 
@@ -488,6 +919,18 @@ namespace quda {
     /** whether to use a memory pool allocator for pinned memory */
     static bool pinned_memory_pool = true;
 
+    /**
+       @brief Read a high-water mark in MiB from the environment
+     */
+    static size_t high_water_env(const char *name)
+    {
+      char *high_water = getenv(name);
+      if (!high_water) return 0;
+      long mb = atol(high_water);
+      if (mb < 0) errorQuda("Invalid %s=%s", name, high_water);
+      return static_cast<size_t>(mb) << 20;
+    }
+
     void init() {
       if (!pool_init) {
 	// device memory pool
@@ -509,116 +952,51 @@ namespace quda {
 	  warningQuda("Not using pinned memory pool allocator");
 	  pinned_memory_pool = false;
 	}
+
+	deviceArena.set_high_water(high_water_env("QUDA_DEVICE_MEMORY_POOL_HIGH_WATER"));
+	pinnedArena.set_high_water(high_water_env("QUDA_PINNED_MEMORY_POOL_HIGH_WATER"));
 	pool_init = true;
       }
     }
 
     void* pinned_malloc_(const char *func, const char *file, int line, size_t nbytes)
     {
-      void *ptr = nullptr;
-      if (pinned_memory_pool) {
-	std::multimap<size_t, void *>::iterator it;
-
-	if (pinnedCache.empty()) {
-	  ptr = quda::pinned_malloc_(func, file, line, nbytes);
-	} else {
-	  it = pinnedCache.lower_bound(nbytes);
-	  if (it != pinnedCache.end()) { // sufficiently large allocation found
-	    nbytes = it->first;
-	    ptr = it->second;
-	    pinnedCache.erase(it);
-	  } else { // sacrifice the smallest cached allocation
-	    it = pinnedCache.begin();
-	    ptr = it->second;
-	    pinnedCache.erase(it);
-	    host_free(ptr);
-	    ptr = quda::pinned_malloc_(func, file, line, nbytes);
-	  }
-	}
-	pinnedSize[ptr] = nbytes;
-      } else {
-	ptr = quda::pinned_malloc_(func, file, line, nbytes);
-      }
-      return ptr;
+      if (pinned_memory_pool) return pinnedArena.allocate(func, file, line, nbytes);
+      else return quda::pinned_malloc_(func, file, line, nbytes);
     }
 
     void pinned_free_(const char *func, const char *file, int line, void *ptr)
     {
-      if (pinned_memory_pool) {
-	if (!pinnedSize.count(ptr)) {
-	  errorQuda("Attempt to free invalid pointer");
-	}
-	pinnedCache.insert(std::make_pair(pinnedSize[ptr], ptr));
-	pinnedSize.erase(ptr);
-      } else {
-	quda::host_free_(func, file, line, ptr);
-      }
+      if (pinned_memory_pool) pinnedArena.free(func, file, line, ptr);
+      else quda::host_free_(func, file, line, ptr);
     }
 
     void* device_malloc_(const char *func, const char *file, int line, size_t nbytes)
     {
-      void *ptr = nullptr;
-      if (device_memory_pool) {
-	std::multimap<size_t, void *>::iterator it;
-
-	if (deviceCache.empty()) {
-	  ptr = quda::device_malloc_(func, file, line, nbytes);
-	} else {
-	  it = deviceCache.lower_bound(nbytes);
-	  if (it != deviceCache.end()) { // sufficiently large allocation found
-	    nbytes = it->first;
-	    ptr = it->second;
-	    deviceCache.erase(it);
-	  } else { // sacrifice the smallest cached allocation
-	    it = deviceCache.begin();
-	    ptr = it->second;
-	    deviceCache.erase(it);
-	    quda::device_free_(func, file, line, ptr);
-	    ptr = quda::device_malloc_(func, file, line, nbytes);
-	  }
-	}
-	deviceSize[ptr] = nbytes;
-      } else {
-	ptr = quda::device_malloc_(func, file, line, nbytes);
-      }
-      return ptr;
+      if (device_memory_pool) return deviceArena.allocate(func, file, line, nbytes);
+      else return quda::device_malloc_(func, file, line, nbytes);
     }
 
     void device_free_(const char *func, const char *file, int line, void *ptr)
     {
-      if (device_memory_pool) {
-	if (!deviceSize.count(ptr)) {
-	  errorQuda("Attempt to free invalid pointer");
-	}
-	deviceCache.insert(std::make_pair(deviceSize[ptr], ptr));
-	deviceSize.erase(ptr);
-      } else {
-	quda::device_free_(func, file, line, ptr);
-      }
+      if (device_memory_pool) deviceArena.free(func, file, line, ptr);
+      else quda::device_free_(func, file, line, ptr);
     }
 
     void flush_pinned()
     {
-      if (pinned_memory_pool) {
-	std::multimap<size_t, void *>::iterator it;
-	for (it = pinnedCache.begin(); it != pinnedCache.end(); it++) {
-	  void *ptr = it->second;
-	  host_free(ptr);
-	}
-	pinnedCache.clear();
-      }
+      if (pinned_memory_pool) pinnedArena.flush();
     }
 
     void flush_device()
     {
-      if (device_memory_pool) {
-	std::multimap<size_t, void *>::iterator it;
-	for (it = deviceCache.begin(); it != deviceCache.end(); it++) {
-	  void *ptr = it->second;
-	  device_free(ptr);
-	}
-	deviceCache.clear();
-      }
+      if (device_memory_pool) deviceArena.flush();
+    }
+
+    void print_stats()
+    {
+      if (device_memory_pool) deviceArena.print_stats();
+      if (pinned_memory_pool) pinnedArena.print_stats();
     }
 
   } // namespace pool
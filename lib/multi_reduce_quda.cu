@@ -56,7 +56,8 @@ namespace quda {
 
   // hooks into tune.cpp variables for policy tuning
   typedef std::map<TuneKey, TuneParam> map;
-  const map& getTuneCache();
+  map getTuneCache();
+  bool tuneCacheContains(const TuneKey &key);
 
   void disableProfileCount();
   void enableProfileCount();
@@ -487,7 +488,7 @@ namespace quda {
       	// before we do policy tuning we must ensure the kernel
       	// constituents have been tuned since we can't do nested tuning
       	// FIXME this will break if the kernels are destructive - which they aren't here
-	if (getTuning() && getTuneCache().find(tuneKey()) == getTuneCache().end()) {
+	if (getTuning() && !tuneCacheContains(tuneKey())) {
 	  disableProfileCount(); // purely for profiling reasons, don't want to profile tunings.
 
 	  if ( x.size()==1 || y.size()==1 ) { // 1-d reduction
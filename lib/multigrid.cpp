@@ -724,6 +724,8 @@ namespace quda {
 
     if ( debug ) printfQuda("entering V-cycle with x2=%e, r2=%e\n", norm2(x), norm2(b));
 
+    TraceScope trace_cycle("cycle", "MG level", param.level + 1);
+
     if (param.level < param.Nlevel-1) {
       //transfer->setTransferGPU(false); // use this to force location of transfer (need to check if still works for multi-level)
       
@@ -743,7 +745,10 @@ namespace quda {
       if (param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE) *b_tilde = *in;
       else b_tilde = &b;
 
-      if (presmoother) (*presmoother)(*out, *in); else zero(*out);
+      {
+        TraceScope trace_smooth("pre-smoother", "MG level", param.level + 1);
+        if (presmoother) (*presmoother)(*out, *in); else zero(*out);
+      }
 
       ColorSpinorField &solution = inner_solution_type == outer_solution_type ? x : x.Even();
       diracSmoother->reconstruct(solution, b, inner_solution_type);
@@ -769,7 +774,10 @@ namespace quda {
       // e.g. in case of iterative setup with MG we use just pre- and post-smoothing at the first iteration.
       if (transfer) {
         // restrict to the coarse grid
-        transfer->R(*r_coarse, residual);
+        {
+          TraceScope trace_restrict("restrict", "MG level", param.level + 1);
+          transfer->R(*r_coarse, residual);
+        }
         if ( debug ) printfQuda("after pre-smoothing x2 = %e, r2 = %e, r_coarse2 = %e\n", norm2(x), r2, norm2(*r_coarse));
 
         // recurse to the next lower level
@@ -781,7 +789,10 @@ namespace quda {
 
         // prolongate back to this grid
         ColorSpinorField &x_coarse_2_fine = inner_solution_type == QUDA_MAT_SOLUTION ? *r : r->Even(); // define according to inner solution type
-        transfer->P(x_coarse_2_fine, *x_coarse); // repurpose residual storage
+        {
+          TraceScope trace_prolong("prolongate", "MG level", param.level + 1);
+          transfer->P(x_coarse_2_fine, *x_coarse); // repurpose residual storage
+        }
 
         xpy(x_coarse_2_fine, solution); // sum to solution FIXME - sum should be done inside the transfer operator
 
@@ -804,7 +815,10 @@ namespace quda {
       // we should keep a copy of the prepared right hand side as we've already destroyed it
       //dirac.prepare(in, out, solution, residual, inner_solution_type);
 
-      if (postsmoother) (*postsmoother)(*out, *in); // for inner solve preconditioned, in the should be the original prepared rhs
+      if (postsmoother) {
+        TraceScope trace_smooth("post-smoother", "MG level", param.level + 1);
+        (*postsmoother)(*out, *in); // for inner solve preconditioned, in the should be the original prepared rhs
+      }
 
       diracSmoother->reconstruct(x, b, outer_solution_type);
 
@@ -814,7 +828,10 @@ namespace quda {
 
       diracSmoother->prepare(in, out, x, b, outer_solution_type);
 
-      if (presmoother) (*presmoother)(*out, *in);
+      if (presmoother) {
+        TraceScope trace_solve("coarse solve", "MG level", param.level + 1);
+        (*presmoother)(*out, *in);
+      }
       diracSmoother->reconstruct(x, b, outer_solution_type);
     }
 
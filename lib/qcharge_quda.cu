@@ -1,6 +1,7 @@
 #include <quda_internal.h>
 #include <quda_matrix.h>
 #include <tune_quda.h>
+#include <host_launch.h>
 #include <gauge_field.h>
 #include <gauge_field_order.h>
 
@@ -20,11 +21,26 @@ namespace quda {
   template<typename Float, typename Gauge>
   struct QChargeArg : public ReduceArg<double> {
     int threads; // number of active threads required
+    int T; // local temporal extent
     Gauge data;
-    QChargeArg(const Gauge &data, GaugeField& Fmunu)
-      : ReduceArg<double>(), data(data), threads(Fmunu.VolumeCB()) {}
+    double *q_t; // optional per-timeslice charge (host only)
+    QChargeArg(const Gauge &data, GaugeField& Fmunu, double *q_t=nullptr)
+      : ReduceArg<double>(), data(data), threads(Fmunu.VolumeCB()), T(Fmunu.X()[3]), q_t(q_t) {}
   };
 
+  // Unnormalized charge density at a given site, from the field strength
+  template<typename Float, typename Arg>
+  __device__ __host__ inline double qChargeSite(Arg &arg, int idx, int parity) {
+    // Load the field-strength tensor from global memory
+    Matrix<complex<Float>,3> F[6];
+    for (int i=0; i<6; ++i) F[i] = arg.data(i, idx, parity);
+
+    double Q1 = getTrace(F[0]*F[5]).real();
+    double Q2 = getTrace(F[1]*F[4]).real();
+    double Q3 = getTrace(F[3]*F[2]).real();
+    return Q1 + Q3 - Q2;
+  }
+
   // Core routine for computing the topological charge from the field strength
   template<int blockSize, typename Float, typename Gauge>
   __global__ void qChargeComputeKernel(QChargeArg<Float,Gauge> arg) {
@@ -34,14 +50,7 @@ namespace quda {
     double Q = 0.0;
 
     while (idx < arg.threads) {
-      // Load the field-strength tensor from global memory
-      Matrix<complex<Float>,3> F[6];
-      for (int i=0; i<6; ++i) F[i] = arg.data(i, idx, parity);
-
-      double Q1 = getTrace(F[0]*F[5]).real();
-      double Q2 = getTrace(F[1]*F[4]).real();
-      double Q3 = getTrace(F[3]*F[2]).real();
-      Q += (Q1 + Q3 - Q2);
+      Q += qChargeSite<Float>(arg, idx, parity);
 
       idx += blockDim.x*gridDim.x;
     }
@@ -62,7 +71,7 @@ namespace quda {
     public:
       QChargeCompute(QChargeArg<Float,Gauge> &arg, GaugeField *vol, QudaFieldLocation location) 
         : arg(arg), vol(vol), location(location) {
-	writeAuxString("threads=%d,prec=%lu",arg.threads,sizeof(Float));
+	writeAuxString("threads=%d,prec=%lu%s",arg.threads,sizeof(Float),arg.q_t ? ",timeslice" : "");
       }
 
       virtual ~QChargeCompute() { }
@@ -73,8 +82,21 @@ namespace quda {
           TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           LAUNCH_KERNEL(qChargeComputeKernel, tp, stream, arg, Float);
           qudaDeviceSynchronize();
+        } else if (arg.q_t) { // run the CPU code, summing each timeslice in turn
+	  // with an even x-dimension each timeslice is a contiguous range of checkerboard sites
+	  const int slice = arg.threads / arg.T;
+	  launchHost(*this, arg.T, [&](int t) {
+	      double Q = 0.0;
+	      for (int parity=0; parity<2; parity++)
+		for (int idx=t*slice; idx<(t+1)*slice; idx++) Q += qChargeSite<Float>(arg, idx, parity);
+	      arg.q_t[t] = Q / (Pi2*Pi2);
+	    });
+	  arg.result_h[0] = 0.;
+	  for (int t=0; t<arg.T; t++) arg.result_h[0] += arg.q_t[t];
         } else { // run the CPU code
-	  errorQuda("qChargeComputeKernel not supported on CPU");
+	  arg.result_h[0] = launchHostReduce(*this, 2*arg.threads, 0.0,
+					     [&](int i) { return qChargeSite<Float>(arg, i % arg.threads, i / arg.threads); },
+					     [](double a, double b) { return a + b; }) / (Pi2*Pi2);
         }
       }
 
@@ -87,30 +109,43 @@ namespace quda {
     };
 
   template<typename Float, typename Gauge>
-    void computeQCharge(const Gauge data, GaugeField& Fmunu, QudaFieldLocation location, Float &qChg){
-      QChargeArg<Float,Gauge> arg(data,Fmunu);
+    void computeQCharge(const Gauge data, GaugeField& Fmunu, QudaFieldLocation location, Float &qChg, double *q_t){
+      // local timeslices are summed into their slot of the global array
+      const int T = Fmunu.X()[3];
+      if (q_t) for (int t=0; t<comm_dim(3)*T; t++) q_t[t] = 0.0;
+
+      QChargeArg<Float,Gauge> arg(data, Fmunu, q_t ? q_t + comm_coord(3)*T : nullptr);
       QChargeCompute<Float,Gauge> qChargeCompute(arg, &Fmunu, location);
       qChargeCompute.apply(0);
       checkCudaError();
       comm_allreduce((double*) arg.result_h);
+      if (q_t) comm_allreduce_array(q_t, comm_dim(3)*T);
       qChg = arg.result_h[0];
     }
 
   template<typename Float>
-    Float computeQCharge(GaugeField &Fmunu, QudaFieldLocation location){
+    Float computeQCharge(GaugeField &Fmunu, QudaFieldLocation location, double *q_t){
       Float res = 0.;
 
-      if (!Fmunu.isNative()) errorQuda("Topological charge computation only supported on native ordered fields");
+      if (!Fmunu.isNative()) {
+	// host fields in MILC order (QDP order only holds four links per site)
+	if (Fmunu.Location() == QUDA_CPU_FIELD_LOCATION && Fmunu.Order() == QUDA_MILC_GAUGE_ORDER) {
+	  typedef typename gauge_order_mapper<Float,QUDA_MILC_GAUGE_ORDER,3>::type Gauge;
+	  computeQCharge<Float>(Gauge(Fmunu), Fmunu, location, res, q_t);
+	  return res;
+	}
+	errorQuda("Topological charge computation only supported on native ordered fields");
+      }
 
       if (Fmunu.Reconstruct() == QUDA_RECONSTRUCT_NO) {
         typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type Gauge;
-        computeQCharge<Float>(Gauge(Fmunu), Fmunu, location, res);
+        computeQCharge<Float>(Gauge(Fmunu), Fmunu, location, res, q_t);
       } else if(Fmunu.Reconstruct() == QUDA_RECONSTRUCT_12){
         typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_12>::type Gauge;
-        computeQCharge<Float>(Gauge(Fmunu), Fmunu, location, res);
+        computeQCharge<Float>(Gauge(Fmunu), Fmunu, location, res, q_t);
       } else if(Fmunu.Reconstruct() == QUDA_RECONSTRUCT_8){
         typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_8>::type Gauge;
-        computeQCharge<Float>(Gauge(Fmunu), Fmunu, location, res);
+        computeQCharge<Float>(Gauge(Fmunu), Fmunu, location, res, q_t);
       } else {
         errorQuda("Reconstruction type %d of gauge field not supported", Fmunu.Reconstruct());
       }
@@ -120,14 +155,18 @@ namespace quda {
     }
 #endif
 
-  double computeQCharge(GaugeField& Fmunu, QudaFieldLocation location){
+  static double computeQCharge(GaugeField& Fmunu, QudaFieldLocation location, double *q_t){
 
     double charge = 0;
 #ifdef GPU_GAUGE_TOOLS
+    if (Fmunu.Location() != location) {
+      errorQuda("Fmunu location %d does not match requested location %d", Fmunu.Location(), location);
+    }
+
     if (Fmunu.Precision() == QUDA_SINGLE_PRECISION){
-      charge = computeQCharge<float>(Fmunu, location);
+      charge = computeQCharge<float>(Fmunu, location, q_t);
     } else if(Fmunu.Precision() == QUDA_DOUBLE_PRECISION) {
-      charge = computeQCharge<double>(Fmunu, location);
+      charge = computeQCharge<double>(Fmunu, location, q_t);
     } else {
       errorQuda("Precision %d not supported", Fmunu.Precision());
     }
@@ -138,5 +177,17 @@ namespace quda {
 
   }
 
+  double computeQCharge(GaugeField& Fmunu, QudaFieldLocation location){
+    return computeQCharge(Fmunu, location, nullptr);
+  }
+
+  double computeQChargeTimeslice(double *q_t, GaugeField& Fmunu){
+    if (Fmunu.Location() != QUDA_CPU_FIELD_LOCATION) {
+      errorQuda("Per-timeslice charge only supported for host fields");
+    }
+    if (Fmunu.X()[0] % 2 != 0) errorQuda("Odd x-dimension %d not supported", Fmunu.X()[0]);
+    return computeQCharge(Fmunu, QUDA_CPU_FIELD_LOCATION, q_t);
+  }
+
 } // namespace quda
 
@@ -274,39 +274,70 @@ doubleN reduceCuda(const double2 &a, const double2 &b,
 }
 
 /**
-   Generic reduce kernel with four loads and up to four stores.
+   Generic reduce kernel with four loads and up to four stores.  On
+   the host each thread accumulates a partial sum over a static
+   partition of the (parity, x_cb) sites, and the partials are then
+   combined in thread order, so that for a given thread count the
+   result is deterministic.  As for genericBlas, sites are loaded and
+   stored whole so that block-float host fields can be written.
   */
-template <typename ReduceType, typename Float, int writeX, int writeY, int writeZ,
+template <typename ReduceType, typename Float, int nSpin, int nColor, int writeX, int writeY, int writeZ,
   int writeW, int writeV, typename SpinorX, typename SpinorY, typename SpinorZ,
   typename SpinorW, typename SpinorV, typename Reducer>
 ReduceType genericReduce(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, SpinorV &V, Reducer r) {
 
-  ReduceType sum;
-  ::quda::zero(sum);
+  constexpr int N = nSpin*nColor;
+  const int volumeCB = X.VolumeCB();
+  const int length = X.Nparity() * volumeCB;
 
-  for (int parity=0; parity<X.Nparity(); parity++) {
-    for (int x=0; x<X.VolumeCB(); x++) {
-      r.pre();
-      for (int s=0; s<X.Nspin(); s++) {
-	for (int c=0; c<X.Ncolor(); c++) {
-	  complex<Float> X_ = X(parity, x, s, c);
-	  complex<Float> Y_ = Y(parity, x, s, c);
-	  complex<Float> Z_ = Z(parity, x, s, c);
-	  complex<Float> W_ = W(parity, x, s, c);
-	  complex<Float> V_ = V(parity, x, s, c);
-	  r(sum, X_, Y_, Z_, W_, V_);
-	  if (writeX) X(parity, x, s, c) = X_;
-	  if (writeY) Y(parity, x, s, c) = Y_;
-	  if (writeZ) Z(parity, x, s, c) = Z_;
-	  if (writeW) W(parity, x, s, c) = W_;
-	  if (writeV) V(parity, x, s, c) = V_;
-	}
-      }
-      r.post(sum);
+#ifdef _OPENMP
+  const int n_thread = omp_get_max_threads();
+#else
+  const int n_thread = 1;
+#endif
+
+  std::vector<ReduceType> partial(n_thread);
+  for (auto &p : partial) ::quda::zero(p);
+
+#pragma omp parallel num_threads(n_thread)
+  {
+#ifdef _OPENMP
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
+    Reducer r_(r); // reducers may carry per-site state between pre() and post()
+    ReduceType sum_;
+    ::quda::zero(sum_);
+
+#pragma omp for schedule(static)
+    for (int i=0; i<length; i++) {
+      const int parity = i / volumeCB;
+      const int x = i - parity * volumeCB;
+      r_.pre();
+      complex<Float> X_[N], Y_[N], Z_[N], W_[N], V_[N];
+      X.load(X_, parity, x);
+      Y.load(Y_, parity, x);
+      Z.load(Z_, parity, x);
+      W.load(W_, parity, x);
+      V.load(V_, parity, x);
+      for (int j=0; j<N; j++) r_(sum_, X_[j], Y_[j], Z_[j], W_[j], V_[j]);
+      if (writeX) X.save(X_, parity, x);
+      if (writeY) Y.save(Y_, parity, x);
+      if (writeZ) Z.save(Z_, parity, x);
+      if (writeW) W.save(W_, parity, x);
+      if (writeV) V.save(V_, parity, x);
+      r_.post(sum_);
     }
+
+    partial[tid] = sum_;
   }
 
-  return sum;
+  // combine the partial sums in a fixed order
+  ReduceType sum_ = partial[0];
+  for (int i=1; i<n_thread; i++) sum(sum_, partial[i]);
+
+  return sum_;
 }
 
 template<typename, int N> struct vector { };
@@ -317,9 +348,11 @@ template <typename ReduceType, typename Float, typename zFloat, int nSpin, int n
   int writeX, int writeY, int writeZ, int writeW, int writeV, typename R>
   ReduceType genericReduce(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z,
 			   ColorSpinorField &w, ColorSpinorField &v, R r) {
-  colorspinor::FieldOrderCB<Float,nSpin,nColor,1,order> X(x), Y(y), W(w), V(v);
-  colorspinor::FieldOrderCB<zFloat,nSpin,nColor,1,order> Z(z);
-  return genericReduce<ReduceType,zFloat,writeX,writeY,writeZ,writeW,writeV>(X, Y, Z, W, V, r);
+  typedef typename mapper<Float>::type RegFloat;
+  typedef typename mapper<zFloat>::type zRegFloat;
+  colorspinor::FieldOrderCB<RegFloat,nSpin,nColor,1,order,Float,Float,false,isFixed<Float>::value> X(x), Y(y), W(w), V(v);
+  colorspinor::FieldOrderCB<zRegFloat,nSpin,nColor,1,order,zFloat,zFloat,false,isFixed<zFloat>::value> Z(z);
+  return genericReduce<ReduceType,zRegFloat,nSpin,nColor,writeX,writeY,writeZ,writeW,writeV>(X, Y, Z, W, V, r);
 }
 
 template <typename ReduceType, typename Float, typename zFloat, int nSpin, QudaFieldOrder order,
@@ -143,6 +143,12 @@ doubleN reduceCuda(const double2 &a, const double2 &b, ColorSpinorField &x,
     } else if (x.Precision() == QUDA_SINGLE_PRECISION) {
       Reducer<doubleN, float2, float2> r(make_float2(a.x, a.y), make_float2(b.x, b.y));
       value = genericReduce<doubleN,doubleN,float,float,writeX,writeY,writeZ,writeW,writeV,Reducer<doubleN,float2,float2> >(x,y,z,w,v,r);
+    } else if (x.Precision() == QUDA_HALF_PRECISION) {
+      Reducer<doubleN, float2, float2> r(make_float2(a.x, a.y), make_float2(b.x, b.y));
+      value = genericReduce<doubleN,doubleN,short,short,writeX,writeY,writeZ,writeW,writeV,Reducer<doubleN,float2,float2> >(x,y,z,w,v,r);
+    } else if (x.Precision() == QUDA_QUARTER_PRECISION) {
+      Reducer<doubleN, float2, float2> r(make_float2(a.x, a.y), make_float2(b.x, b.y));
+      value = genericReduce<doubleN,doubleN,char,char,writeX,writeY,writeZ,writeW,writeV,Reducer<doubleN,float2,float2> >(x,y,z,w,v,r);
     } else {
       errorQuda("Precision %d not implemented", x.Precision());
     }
@@ -1,3 +1,8 @@
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <blas_quda.h>
 #include <tune_quda.h>
 #include <float_vector.h>
@@ -2,6 +2,7 @@
 #include <invert_quda.h>
 #include <multigrid.h>
 #include <cmath>
+#include <cstdio>
 
 namespace quda {
 
@@ -192,7 +193,9 @@ namespace quda {
     return true;
   }
 
-  void Solver::PrintStats(const char* name, int k, double r2, double b2, double hq2) {
+  void Solver::PrintStats(const char* name, int k, double r2, double b2, double hq2, bool record) {
+    if (record) param.history.record(name, k, r2, b2, hq2);
+
     if (getVerbosity() >= QUDA_VERBOSE) {
       if (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) {
 	printfQuda("%s: %d iterations, <r,r> = %e, |r|/|b| = %e, heavy-quark residual = %e\n",
@@ -208,6 +211,8 @@ namespace quda {
 
   void Solver::PrintSummary(const char *name, int k, double r2, double b2,
                             double r2_tol, double hq_tol) {
+    param.history.record(name, k, r2, b2, param.true_res_hq, param.compute_true_res ? param.true_res * param.true_res * b2 : -1.0);
+
     if (getVerbosity() >= QUDA_SUMMARIZE) {
       if (param.compute_true_res) {
 	if (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) {
@@ -232,6 +237,48 @@ namespace quda {
   }
 
 
+  void SolverHistory::record(const char *name, int k, double r2, double b2, double hq2, double true_r2)
+  {
+    if (!enabled) return;
+    if (solver.empty()) solver = name;
+
+    QudaSolverHistoryEntry entry;
+    entry.iter = k;
+    entry.residual = sqrt(r2 / b2);
+    entry.true_residual = true_r2 >= 0.0 ? sqrt(true_r2 / b2) : -1.0;
+    entry.heavy_quark_residual = hq2;
+    entry.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    entries.push_back(entry);
+  }
+
+  void SolverHistory::update(QudaInvertParam &param)
+  {
+    if (!enabled || n_written == entries.size()) return;
+
+    if (param.history) {
+      size_t i = n_written;
+      for (; i < entries.size() && param.history_length < param.history_max_length; i++)
+        param.history[param.history_length++] = entries[i];
+      if (i < entries.size()) warningQuda("Solver history truncated to %d entries", param.history_max_length);
+    }
+
+    if (strlen(param.history_file) > 0 && comm_rank() == 0) {
+      FILE *file = fopen(param.history_file, "a");
+      if (file) {
+        fprintf(file, "# %s\n# iter\tresidual\ttrue_residual\thq_residual\tsecs\n", solver.c_str());
+        for (size_t i = n_written; i < entries.size(); i++) {
+          const QudaSolverHistoryEntry &e = entries[i];
+          fprintf(file, "%d\t%e\t%e\t%e\t%e\n", e.iter, e.residual, e.true_residual, e.heavy_quark_residual, e.secs);
+        }
+        fclose(file);
+      } else {
+        warningQuda("Unable to open solver history file %s", param.history_file);
+      }
+    }
+
+    n_written = entries.size();
+  }
+
   bool MultiShiftSolver::convergence(const double *r2, const double *r2_tol, int n) const {
 
     for (int i=0; i<n; i++) {
@@ -11,6 +11,7 @@
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
 #include <tune_quda.h>
+#include <host_launch.h>
 #include <utility> // for std::swap
 #include <random_quda.h>
 
@@ -45,20 +46,20 @@ namespace quda {
 
   /** CPU function to reorder spinor fields.  */
   template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg>
-  void SpinorNoiseCPU(Arg &arg) {
-
-    for (int parity=0; parity<arg.nParity; parity++) {
-      for (int x_cb=0; x_cb<arg.volumeCB; x_cb++) {
-        for (int s=0; s<Ns; s++) {
-          for (int c=0; c<Nc; c++) {
-            cuRNGState localState = arg.rng.State()[parity+2*x_cb];
-            if (type == QUDA_NOISE_GAUSS) genGauss<real>(arg, localState, parity, x_cb, s, c);
-            else if (type == QUDA_NOISE_UNIFORM) genUniform<real>(arg, localState, parity, x_cb, s, c);
-            arg.rng.State()[parity+2*x_cb] = localState;
-          }
+  void SpinorNoiseCPU(Tunable &tunable, Arg &arg) {
+
+    launchHost(tunable, arg.nParity * arg.volumeCB, [&](int i) {
+      const int x_cb = i % arg.volumeCB;
+      const int parity = i / arg.volumeCB;
+      cuRNGState localState = arg.rng.State()[parity+2*x_cb];
+      for (int s=0; s<Ns; s++) {
+        for (int c=0; c<Nc; c++) {
+          if (type == QUDA_NOISE_GAUSS) genGauss<real>(arg, localState, parity, x_cb, s, c);
+          else if (type == QUDA_NOISE_UNIFORM) genUniform<real>(arg, localState, parity, x_cb, s, c);
         }
       }
-    }
+      arg.rng.State()[parity+2*x_cb] = localState;
+    });
   }
 
   /** CUDA kernel to reorder spinor fields.  Adopts a similar form as the CPU version, using the same inlined functions. */
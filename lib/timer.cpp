@@ -1,3 +1,9 @@
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <mutex>
+#include <atomic>
 #include <quda_internal.h>
 #include <timer.h>
 
@@ -85,4 +91,119 @@ namespace quda {
 
   }
 
+  /**
+     A single complete ("X") event in the trace.  Times are stored in
+     microseconds relative to the trace epoch.
+  */
+  struct TraceEvent {
+    std::string name;
+    std::string cat;
+    double ts;
+    double dur;
+    int tid; /** index of the host thread that recorded the event */
+  };
+
+  // upper bound on the number of events we buffer per process
+  static constexpr size_t trace_max_events = 1 << 22;
+
+  static std::vector<TraceEvent> trace_events;
+  static bool trace_overflow = false;
+  static std::mutex trace_mutex; // protects trace_events and trace_overflow
+
+  static const char *trace_prefix()
+  {
+    static const char *prefix = getenv("QUDA_PROFILE_TRACE");
+    return prefix && strlen(prefix) > 0 ? prefix : nullptr;
+  }
+
+  // all trace timestamps are relative to the first time tracing is queried
+  static timer_clock::time_point trace_epoch()
+  {
+    static const timer_clock::time_point epoch = timer_clock::now();
+    return epoch;
+  }
+
+  // host threads are numbered in the order they first record an event
+  static int trace_tid()
+  {
+    static std::atomic<int> n_threads(0);
+    static thread_local const int tid = n_threads++;
+    return tid;
+  }
+
+  bool TimeProfile::TraceEnabled()
+  {
+    static const bool enabled = (trace_epoch(), trace_prefix() != nullptr);
+    return enabled;
+  }
+
+  void TimeProfile::TraceRecord(const std::string &name, const std::string &cat, timer_clock::time_point start,
+                                timer_clock::time_point stop)
+  {
+    TraceEvent event;
+    event.name = name;
+    event.cat = cat;
+    event.ts = std::chrono::duration<double, std::micro>(start - trace_epoch()).count();
+    event.dur = std::chrono::duration<double, std::micro>(stop - start).count();
+    event.tid = trace_tid();
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (trace_events.size() >= trace_max_events) {
+      if (!trace_overflow) warningQuda("Trace buffer full (%lu events), further events will be dropped", trace_events.size());
+      trace_overflow = true;
+      return;
+    }
+    trace_events.push_back(std::move(event));
+  }
+
+  // escape a string for use as a JSON string
+  static std::string jsonEscape(const std::string &str)
+  {
+    std::string escaped;
+    for (char c : str) {
+      switch (c) {
+      case '"': escaped += "\\\""; break;
+      case '\\': escaped += "\\\\"; break;
+      case '\n': escaped += "\\n"; break;
+      case '\t': escaped += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char code[8];
+          snprintf(code, sizeof(code), "\\u%04x", c);
+          escaped += code;
+        } else {
+          escaped += c;
+        }
+      }
+    }
+    return escaped;
+  }
+
+  void TimeProfile::WriteTrace(int rank)
+  {
+    if (!TraceEnabled()) return;
+
+    char filename[1024];
+    snprintf(filename, sizeof(filename), "%s.%d.json", trace_prefix(), rank);
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+      warningQuda("Unable to open trace file %s", filename);
+      return;
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"rank %d\"}}",
+            rank, rank);
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    for (auto &event : trace_events) {
+      fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+              jsonEscape(event.name).c_str(), jsonEscape(event.cat).c_str(), event.ts, event.dur, rank, event.tid);
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Wrote %lu trace events to %s\n", trace_events.size(), filename);
+  }
+
 }
@@ -2,12 +2,14 @@
 #include <comm_quda.h>
 #include <quda.h> // for QUDA_VERSION_STRING
 #include <sys/stat.h> // for stat()
+#include <sys/file.h> // for flock()
 #include <fcntl.h>
 #include <cfloat> // for FLT_MAX
 #include <ctime>
 #include <fstream>
 #include <typeinfo>
 #include <map>
+#include <unordered_map>
 #include <list>
 #include <unistd.h>
 #include <uint_to_char.h>
@@ -15,14 +17,18 @@
 #include <deque>
 #include <queue>
 #include <functional>
-#ifdef PTHREADS
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <chrono>
+#include <stdint.h>
+#include <mutex>
 #include <pthread.h>
-#endif
 
 //#define LAUNCH_TIMER
 extern char* gitversion;
 
-namespace quda { static TuneKey last_key; }
+namespace quda { static thread_local TuneKey last_key; }
 
 // intentionally leave this outside of the namespace for now
 quda::TuneKey getLastTuneKey() { return quda::last_key; }
@@ -71,6 +77,7 @@ namespace quda {
 
   // linked list that is augmented each time we call a kernel
   static std::list<TraceKey> trace_list;
+  static std::mutex trace_mutex; // protects trace_list and the launch trace
   static int enable_trace = 0;
 
   int traceEnabled() {
@@ -102,39 +109,236 @@ namespace quda {
       strcat(aux,tmp);
       TuneKey key("", func, aux);
       TraceKey trace_entry(key, 0.0);
+      std::lock_guard<std::mutex> lock(trace_mutex);
       trace_list.push_back(trace_entry);
     }
   }
 
+  /**
+     How the duration of a launch in the launch trace is measured.
+     Host launches report their wall time through postLaunchTime().
+     Device launches are not timed individually, since that would
+     need events on the stream of every launch, so they are reported
+     with the autotuner's time for their launch configuration.
+   */
+  enum LaunchTiming {
+    LAUNCH_TUNED, // autotuner's time per call for this configuration
+    LAUNCH_HOST   // host wall time reported by the launcher
+  };
+
+  /**
+     A single record of the launch trace.  This is plain old data so
+     that the launch trace can be kept in a fixed-size binary ring
+     buffer; the kernel is referred to by an index into the table of
+     traced keys rather than by a copy of its TuneKey.
+  */
+  struct LaunchRecord {
+    size_t seq;       /** sequence number of this launch */
+    double timestamp; /** launch time in microseconds since the trace started */
+    double interval;  /** host time in microseconds until the next traced launch */
+    double time;      /** duration of this launch in seconds, see LaunchTiming */
+    float tune_time;  /** time per call in seconds measured by the autotuner for this launch configuration */
+    int timing;       /** LaunchTiming of this record */
+    int key;          /** index into launch_trace_keys */
+    int block[3];
+    int grid[3];
+    int shared_bytes;
+    int aux[4];
+    long long flops;
+    long long bytes;
+  };
+
+  static std::vector<LaunchRecord> launch_trace;  // ring buffer
+  static size_t launch_trace_count = 0;          // total number of records posted
+  static std::vector<TuneKey> launch_trace_keys; // distinct keys referred to by the trace
+  static std::map<TuneKey, int> launch_trace_index;
+  static std::chrono::steady_clock::time_point launch_trace_start_time;
+  static thread_local size_t launch_trace_pending = 0; // 1 + sequence number of the last launch traced by this thread
+
+  /**
+     @brief Post a kernel launch to the launch trace ring buffer.
+     Once the buffer is full the oldest records are overwritten.  The
+     size of the buffer (in records) is set with
+     QUDA_TRACE_BUFFER_SIZE, defaulting to 2^16.
+   */
+  static void postLaunchTrace(const TuneKey &key, const TuneParam &param, long long flops, long long bytes)
+  {
+    auto now = std::chrono::steady_clock::now();
+
+    if (launch_trace.size() == 0) {
+      char *size_env = getenv("QUDA_TRACE_BUFFER_SIZE");
+      long size = size_env ? atol(size_env) : 1 << 16;
+      if (size <= 0) errorQuda("Invalid QUDA_TRACE_BUFFER_SIZE=%s", size_env);
+      launch_trace.resize(size);
+      launch_trace_start_time = now;
+    }
+
+    const double timestamp = std::chrono::duration<double, std::micro>(now - launch_trace_start_time).count();
+    if (launch_trace_count > 0) {
+      LaunchRecord &prev = launch_trace[(launch_trace_count - 1) % launch_trace.size()];
+      prev.interval = timestamp - prev.timestamp;
+    }
+
+    auto index = launch_trace_index.find(key);
+    if (index == launch_trace_index.end()) {
+      index = launch_trace_index.insert(std::make_pair(key, static_cast<int>(launch_trace_keys.size()))).first;
+      launch_trace_keys.push_back(key);
+    }
+
+    LaunchRecord &record = launch_trace[launch_trace_count % launch_trace.size()];
+    record.seq = launch_trace_count;
+    record.timestamp = timestamp;
+    record.interval = 0.0;
+    record.time = param.time;
+    record.tune_time = param.time;
+    record.timing = LAUNCH_TUNED;
+    record.key = index->second;
+    record.block[0] = param.block.x;
+    record.block[1] = param.block.y;
+    record.block[2] = param.block.z;
+    record.grid[0] = param.grid.x;
+    record.grid[1] = param.grid.y;
+    record.grid[2] = param.grid.z;
+    record.shared_bytes = param.shared_bytes;
+    record.aux[0] = param.aux.x;
+    record.aux[1] = param.aux.y;
+    record.aux[2] = param.aux.z;
+    record.aux[3] = param.aux.w;
+    record.flops = flops;
+    record.bytes = bytes;
+
+    launch_trace_pending = ++launch_trace_count;
+  }
+
+  void postLaunchTime(double time)
+  {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (!launch_trace_pending || launch_trace_count - (launch_trace_pending - 1) > launch_trace.size()) return;
+    LaunchRecord &record = launch_trace[(launch_trace_pending - 1) % launch_trace.size()];
+    record.time = time;
+    record.timing = LAUNCH_HOST;
+  }
+
+  // quote a string as a CSV field
+  static std::string csvQuote(const char *str)
+  {
+    std::string quoted = "\"";
+    for (const char *c = str; *c; c++) {
+      if (*c == '"') quoted += '"';
+      quoted += *c;
+    }
+    return quoted + "\"";
+  }
+
+  /**
+     @brief Dump the launch trace ring buffer of this process as CSV,
+     oldest record first.  Alongside the launch parameters, each row
+     gives the duration of the launch (see LaunchTiming) and the
+     Gflop/s and GB/s this corresponds to, giving a roofline table for
+     every launch of the job.  The autotuner's time for the launch
+     configuration is reported separately for comparison.
+   */
+  static void serializeLaunchTrace(std::ostream &out)
+  {
+    out << "timestamp_us,interval_us,time_us,timing,flops,bytes,gflops,gbytes,tune_time_us,";
+    out << "block_x,block_y,block_z,grid_x,grid_y,grid_z,shared_bytes,aux_x,aux_y,aux_z,aux_w,volume,name,aux" << std::endl;
+
+    const size_t n = std::min(launch_trace_count, launch_trace.size());
+    for (size_t i = launch_trace_count - n; i < launch_trace_count; i++) {
+      const LaunchRecord &record = launch_trace[i % launch_trace.size()];
+      const TuneKey &key = launch_trace_keys[record.key];
+      const bool timed = record.time > 0.0 && record.time < FLT_MAX;
+      const bool tuned = record.tune_time > 0.0 && record.tune_time < FLT_MAX;
+      out << std::fixed << std::setprecision(3) << record.timestamp << "," << record.interval << ",";
+      if (timed) out << 1e6 * record.time;
+      out << "," << (record.timing == LAUNCH_HOST ? "host" : "tuned");
+      out << "," << record.flops << "," << record.bytes << ",";
+      if (timed) out << std::setprecision(2) << record.flops / (1e9 * record.time);
+      out << ",";
+      if (timed) out << std::setprecision(2) << record.bytes / (1e9 * record.time);
+      out << ",";
+      if (tuned) out << std::setprecision(3) << 1e6 * record.tune_time;
+      out << "," << record.block[0] << "," << record.block[1] << "," << record.block[2];
+      out << "," << record.grid[0] << "," << record.grid[1] << "," << record.grid[2];
+      out << "," << record.shared_bytes;
+      out << "," << record.aux[0] << "," << record.aux[1] << "," << record.aux[2] << "," << record.aux[3];
+      out << "," << csvQuote(key.volume) << "," << csvQuote(key.name) << "," << csvQuote(key.aux) << std::endl;
+    }
+  }
+
   static const std::string quda_hash = QUDA_HASH; // defined in lib/Makefile
   static std::string resource_path;
   static map tunecache;
-  static map::iterator it;
   static size_t initial_cache_size = 0;
 
+  /** hashed index in front of tunecache, see findTuneEntry() */
+  static std::unordered_map<uint64_t, map::iterator> tunecache_index;
+
+  /**
+     Reader-writer lock protecting tunecache together with its index,
+     journal and version tags.  Launches of cached kernels hold it
+     shared, while anything that modifies the cache holds it
+     exclusive.  The exclusive lock is re-entrant within a thread,
+     since errorQuda() saves the cache wherever it is raised.
+   */
+  static pthread_rwlock_t tunecache_rwlock = PTHREAD_RWLOCK_INITIALIZER;
+  static thread_local int tunecache_write_depth = 0;
+
+  class TuneCacheReadLock {
+  public:
+    TuneCacheReadLock() { if (!tunecache_write_depth) pthread_rwlock_rdlock(&tunecache_rwlock); }
+    ~TuneCacheReadLock() { if (!tunecache_write_depth) pthread_rwlock_unlock(&tunecache_rwlock); }
+  };
+
+  class TuneCacheWriteLock {
+  public:
+    TuneCacheWriteLock() { if (tunecache_write_depth++ == 0) pthread_rwlock_wrlock(&tunecache_rwlock); }
+    ~TuneCacheWriteLock() { if (--tunecache_write_depth == 0) pthread_rwlock_unlock(&tunecache_rwlock); }
+  };
+
+  /** held by the thread that is tuning, so that one kernel is tuned at a time */
+  static std::mutex tuner_mutex;
+
+  /** keys tuned since the cache was last written to disk */
+  static std::set<TuneKey> tunecache_journal;
+
+  /** number of records in the on-disk binary cache (including superseded ones) */
+  static size_t tunecache_file_records = 0;
+  static bool tunecache_file_exists = false;
+
 #define STR_(x) #x
 #define STR(x) STR_(x)
   static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VERSION_MINOR) "." STR(QUDA_VERSION_SUBMINOR);
 #undef STR
 #undef STR_
 
-  /** tuning in progress? */
-  static bool tuning = false;
+  /** tuning in progress on this thread? */
+  static thread_local bool tuning = false;
 
   bool activeTuning() { return tuning; }
 
-  static bool profile_count = true;
+  static thread_local bool profile_count = true;
 
   void disableProfileCount() { profile_count = false; }
   void enableProfileCount() { profile_count = true; }
 
-  const map& getTuneCache() { return tunecache; }
+  map getTuneCache()
+  {
+    TuneCacheReadLock lock;
+    return tunecache;
+  }
+
+  bool tuneCacheContains(const TuneKey &key)
+  {
+    TuneCacheReadLock lock;
+    return tunecache.find(key) != tunecache.end();
+  }
 
 
   /**
    * Deserialize tunecache from an istream, useful for reading a file or receiving from other nodes.
    */
-  static void deserializeTuneCache(std::istream &in)
+  static void deserializeTuneCache(std::istream &in, map &cache = tunecache)
   {
     std::string line;
     std::stringstream ls;
@@ -164,7 +368,7 @@ namespace quda {
       ls.ignore(1); // throw away tab before comment
       getline(ls, param.comment); // assume anything remaining on the line is a comment
       param.comment += "\n"; // our convention is to include the newline, since ctime() likes to do this
-      tunecache[key] = param;
+      cache[key] = param;
     }
   }
 
@@ -172,11 +376,11 @@ namespace quda {
   /**
    * Serialize tunecache to an ostream, useful for writing to a file or sending to other nodes.
    */
-  static void serializeTuneCache(std::ostream &out)
+  static void serializeTuneCache(std::ostream &out, const map &cache = tunecache)
   {
-    map::iterator entry;
+    map::const_iterator entry;
 
-    for (entry = tunecache.begin(); entry != tunecache.end(); entry++) {
+    for (entry = cache.begin(); entry != cache.end(); entry++) {
       TuneKey key = entry->first;
       TuneParam param = entry->second;
 
@@ -189,6 +393,401 @@ namespace quda {
   }
 
 
+  /**
+     The binary tunecache consists of a header (magic, format version,
+     QUDA version, git version and build hash) followed by a sequence
+     of records.  Each record begins with a 64-bit hash of its TuneKey,
+     which lets us detect a torn record at the end of the file.  Newly
+     tuned entries are appended to the end of the file, so when a key
+     appears more than once the last record wins.
+
+     Since format 2 each record also carries a tag identifying the
+     QUDA version that tuned (or last validated) it, so that a rebuild
+     only invalidates the entries that no longer fit the kernels rather
+     than the whole cache.  Format 1 records inherit the tag of the
+     header.  A change of build hash (architecture or CUDA version)
+     still invalidates the whole cache.
+   */
+  static const char tunecache_magic[8] = {'Q','U','D','A','T','U','N','E'};
+  static const uint32_t tunecache_format = 2;
+
+  struct TuneCacheHeader {
+    uint32_t format;
+    std::string version;
+    std::string gitversion;
+    std::string hash;
+  };
+
+  /**
+     @brief The header describing the present build
+   */
+  static TuneCacheHeader currentTuneCacheHeader()
+  {
+    TuneCacheHeader header;
+    header.format = tunecache_format;
+    header.version = quda_version;
+#ifdef GITVERSION
+    header.gitversion = gitversion;
+#else
+    header.gitversion = quda_version;
+#endif
+    header.hash = quda_hash;
+    return header;
+  }
+
+  /**
+     @brief Tag identifying the QUDA version that wrote a tunecache
+   */
+  static std::string tuneEntryTag(const TuneCacheHeader &header) { return header.version + "/" + header.gitversion; }
+
+  static const std::string &currentTuneEntryTag()
+  {
+    static const std::string tag = tuneEntryTag(currentTuneCacheHeader());
+    return tag;
+  }
+
+  /** version tags of cache entries that have not yet been validated against this build */
+  typedef std::map<TuneKey, std::string> tag_map;
+  static tag_map tunecache_unverified;
+
+  /** entries dropped since the last save since they are no longer valid for this build */
+  static std::vector<TuneKey> tunecache_invalidated;
+
+  static const std::string &tuneEntryTag(const TuneKey &key, const tag_map &tags = tunecache_unverified)
+  {
+    auto tag = tags.find(key);
+    return tag == tags.end() ? currentTuneEntryTag() : tag->second;
+  }
+
+  /**
+     @brief Record the version that a tunecache entry was tuned with,
+     marking it for validation on first use if it is not this one
+   */
+  static void setTuneEntryTag(const TuneKey &key, const std::string &tag)
+  {
+    if (tag == currentTuneEntryTag()) tunecache_unverified.erase(key);
+    else tunecache_unverified[key] = tag;
+  }
+
+  /**
+     @brief 64-bit FNV-1a hash of a TuneKey
+   */
+  static uint64_t hashTuneKey(const TuneKey &key)
+  {
+    uint64_t hash = 14695981039346656037ull;
+    auto fnv = [&hash](const char *str) {
+      for (const char *c = str; ; c++) {
+	hash ^= static_cast<unsigned char>(*c);
+	hash *= 1099511628211ull;
+	if (*c == '\0') break; // include the terminator so "ab","c" != "a","bc"
+      }
+    };
+    fnv(key.volume);
+    fnv(key.name);
+    fnv(key.aux);
+    return hash;
+  }
+
+  /**
+     @brief Look up a key in the tunecache.  Hits are remembered in a
+     hashed index (std::map iterators stay valid until their entry is
+     erased), so repeated launches cost a hash lookup and a single key
+     comparison instead of a tree walk of string comparisons.  This
+     only reads the cache and index, so that it may be called with the
+     tunecache locked for reading; entries found outside the index are
+     added with indexTuneEntry().
+     @param[in] key Key to look up
+     @param[in] hash Hash of the key, from hashTuneKey()
+     @param[out] indexed Whether the entry was found through the index
+     @return Iterator to the entry, or tunecache.end() if not present
+   */
+  static map::iterator findTuneEntry(const TuneKey &key, uint64_t hash, bool &indexed)
+  {
+    auto index = tunecache_index.find(hash);
+    if (index != tunecache_index.end()) {
+      const TuneKey &entry = index->second->first;
+      if (!strcmp(entry.aux, key.aux) && !strcmp(entry.name, key.name) && !strcmp(entry.volume, key.volume)) {
+        indexed = true;
+        return index->second;
+      }
+    }
+    indexed = false;
+    return tunecache.find(key);
+  }
+
+  /**
+     @brief Add an entry to the hashed index.  Must be called with the
+     tunecache locked for writing.
+   */
+  static void indexTuneEntry(const TuneKey &key, uint64_t hash)
+  {
+    auto entry = tunecache.find(key);
+    if (entry != tunecache.end()) tunecache_index[hash] = entry;
+  }
+
+  template <typename T> static inline void writeBinary(std::ostream &out, const T &value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T> static inline bool readBinary(std::istream &in, T &value)
+  {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return in.gcount() == sizeof(T);
+  }
+
+  static inline void writeString(std::ostream &out, const char *str)
+  {
+    uint32_t length = strlen(str);
+    writeBinary(out, length);
+    out.write(str, length);
+  }
+
+  static inline bool readString(std::istream &in, char *str, uint32_t max_length)
+  {
+    uint32_t length;
+    if (!readBinary(in, length) || length >= max_length) return false;
+    in.read(str, length);
+    str[length] = '\0';
+    return in.gcount() == length;
+  }
+
+  static inline bool readString(std::istream &in, std::string &str)
+  {
+    uint32_t length;
+    if (!readBinary(in, length)) return false;
+    str.resize(length);
+    if (length) in.read(&str[0], length);
+    return in.gcount() == length;
+  }
+
+  static void serializeTuneCacheHeader(std::ostream &out, const TuneCacheHeader &header)
+  {
+    out.write(tunecache_magic, sizeof(tunecache_magic));
+    writeBinary(out, tunecache_format);
+    writeString(out, header.version.c_str());
+    writeString(out, header.gitversion.c_str());
+    writeString(out, header.hash.c_str());
+  }
+
+  static bool deserializeTuneCacheHeader(std::istream &in, TuneCacheHeader &header)
+  {
+    char magic[sizeof(tunecache_magic)];
+    uint32_t format;
+    in.read(magic, sizeof(magic));
+    if (in.gcount() != sizeof(magic) || memcmp(magic, tunecache_magic, sizeof(magic))) return false;
+    if (!readBinary(in, format) || format < 1 || format > tunecache_format) return false;
+    header.format = format;
+    return readString(in, header.version) && readString(in, header.gitversion) && readString(in, header.hash);
+  }
+
+  static void serializeTuneEntry(std::ostream &out, const TuneKey &key, const TuneParam &param, const std::string &tag)
+  {
+    writeBinary(out, hashTuneKey(key));
+    writeString(out, key.volume);
+    writeString(out, key.name);
+    writeString(out, key.aux);
+    const uint32_t launch[] = { param.block.x, param.block.y, param.block.z, param.grid.x, param.grid.y, param.grid.z };
+    const int32_t aux[] = { param.shared_bytes, param.aux.x, param.aux.y, param.aux.z, param.aux.w };
+    writeBinary(out, launch);
+    writeBinary(out, aux);
+    writeBinary(out, param.time);
+    writeString(out, param.comment.c_str());
+    writeString(out, tag.c_str());
+  }
+
+  /**
+     @return false if the end of the stream has been reached or the record is incomplete or corrupt
+   */
+  static bool deserializeTuneEntry(std::istream &in, TuneKey &key, TuneParam &param, std::string &tag, uint32_t format)
+  {
+    uint64_t hash;
+    uint32_t launch[6];
+    int32_t aux[5];
+
+    if (!readBinary(in, hash)) return false;
+    if (!readString(in, key.volume, key.volume_n) || !readString(in, key.name, key.name_n) ||
+	!readString(in, key.aux, key.aux_n)) return false;
+    if (!readBinary(in, launch) || !readBinary(in, aux) || !readBinary(in, param.time)) return false;
+    if (!readString(in, param.comment)) return false;
+    if (format >= 2 && !readString(in, tag)) return false;
+
+    param.block = dim3(launch[0], launch[1], launch[2]);
+    param.grid = dim3(launch[3], launch[4], launch[5]);
+    param.shared_bytes = aux[0];
+    param.aux = make_int4(aux[1], aux[2], aux[3], aux[4]);
+    return hash == hashTuneKey(key);
+  }
+
+  /**
+   * Serialize tunecache in binary form, used for the on-disk cache and for sending to other nodes.
+   */
+  static void serializeTuneCacheBinary(std::ostream &out, const map &cache = tunecache, const tag_map &tags = tunecache_unverified)
+  {
+    for (auto &entry : cache) serializeTuneEntry(out, entry.first, entry.second, tuneEntryTag(entry.first, tags));
+  }
+
+  /**
+   * Deserialize binary tunecache records until the end of the stream.
+   * Entries whose tag differs from the present version are recorded in tags.
+   * @return Number of records read
+   */
+  static size_t deserializeTuneCacheBinary(std::istream &in, map &cache, tag_map &tags,
+					   const TuneCacheHeader &header = currentTuneCacheHeader())
+  {
+    size_t count = 0;
+    TuneKey key;
+    TuneParam param;
+    std::string tag = tuneEntryTag(header); // format 1 records inherit the header's tag
+    while (in.peek() != std::char_traits<char>::eof()) {
+      if (!deserializeTuneEntry(in, key, param, tag, header.format)) {
+	warningQuda("Discarding incomplete or corrupt tunecache record after %lu records", count);
+	break;
+      }
+      cache[key] = param;
+      if (tag != currentTuneEntryTag()) tags[key] = tag;
+      else tags.erase(key);
+      count++;
+    }
+    return count;
+  }
+
+  /**
+   * Replace the entries of the tunecache with those given, along with their version tags.
+   */
+  static void adoptTuneCache(const map &cache, const tag_map &tags)
+  {
+    for (auto &entry : cache) {
+      tunecache[entry.first] = entry.second;
+      setTuneEntryTag(entry.first, tuneEntryTag(entry.first, tags));
+    }
+  }
+
+  /**
+     @brief Read the header of a TSV tunecache
+   */
+  static bool readTuneCacheHeaderTSV(std::istream &in, TuneCacheHeader &header)
+  {
+    std::string line, token;
+    std::stringstream ls;
+    if (!in.good()) return false;
+    getline(in, line);
+    ls.str(line);
+    ls >> token;
+    if (token.compare("tunecache")) return false;
+    ls >> header.version >> header.gitversion >> header.hash;
+    if (!in.good()) return false;
+    getline(in, line); // eat the blank line
+    if (!in.good()) return false;
+    getline(in, line); // eat the description line
+    return true;
+  }
+
+  static void writeTuneCacheHeaderTSV(std::ostream &out, const TuneCacheHeader &header)
+  {
+    time_t now;
+    time(&now);
+    out << "tunecache\t" << header.version << "\t" << header.gitversion;
+    out << "\t" << header.hash << "\t# Last updated " << ctime(&now) << std::endl;
+    out << std::setw(16) << "volume" << "\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\taux.x\taux.y\taux.z\taux.w\ttime\tcomment" << std::endl;
+  }
+
+  /**
+     @brief Check whether a cache file is usable with the present build.
+     Launch parameters are specific to the architecture and CUDA
+     version, so if the build hash differs the whole cache is
+     discarded.  If only the QUDA version differs the entries are kept
+     and each is validated on its first use.
+   */
+  static bool checkTuneCacheHeader(const TuneCacheHeader &header, const std::string &cache_path)
+  {
+    const TuneCacheHeader current = currentTuneCacheHeader();
+    if (header.hash.compare(current.hash)) {
+      warningQuda("Cache file %s does not match current QUDA build (%s vs %s) and will be ignored.",
+		  cache_path.c_str(), header.hash.c_str(), current.hash.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  /**
+     @brief Whether to use the legacy TSV on-disk format (QUDA_TUNECACHE_FORMAT=tsv)
+   */
+  static bool tuneCacheTSV()
+  {
+    static bool init = false;
+    static bool tsv = false;
+    if (!init) {
+      char *format_env = getenv("QUDA_TUNECACHE_FORMAT");
+      if (format_env) {
+	if (strcmp(format_env, "tsv") == 0) tsv = true;
+	else if (strcmp(format_env, "binary") != 0) errorQuda("Unknown QUDA_TUNECACHE_FORMAT=%s (valid options are tsv or binary)", format_env);
+      }
+      init = true;
+    }
+    return tsv;
+  }
+
+  void exportTuneCache(const std::string &bin_path, const std::string &tsv_path)
+  {
+    std::ifstream in(bin_path.c_str(), std::ios::binary);
+    if (!in) errorQuda("Unable to open %s", bin_path.c_str());
+    TuneCacheHeader header;
+    if (!deserializeTuneCacheHeader(in, header)) errorQuda("Bad format in %s", bin_path.c_str());
+    map cache;
+    tag_map tags;
+    deserializeTuneCacheBinary(in, cache, tags, header);
+    in.close();
+
+    std::ofstream out(tsv_path.c_str());
+    if (!out) errorQuda("Unable to open %s", tsv_path.c_str());
+    writeTuneCacheHeaderTSV(out, header);
+    serializeTuneCache(out, cache);
+    out.close();
+    printfQuda("Exported %lu sets of cached parameters from %s to %s\n", cache.size(), bin_path.c_str(), tsv_path.c_str());
+  }
+
+  void importTuneCache(const std::string &tsv_path, const std::string &bin_path)
+  {
+    std::ifstream in(tsv_path.c_str());
+    if (!in) errorQuda("Unable to open %s", tsv_path.c_str());
+    TuneCacheHeader header;
+    if (!readTuneCacheHeaderTSV(in, header)) errorQuda("Bad format in %s", tsv_path.c_str());
+    map cache;
+    deserializeTuneCache(in, cache);
+    in.close();
+
+    std::ofstream out(bin_path.c_str(), std::ios::binary);
+    if (!out) errorQuda("Unable to open %s", bin_path.c_str());
+    serializeTuneCacheHeader(out, header);
+    tag_map tags;
+    for (auto &entry : cache) tags[entry.first] = tuneEntryTag(header);
+    serializeTuneCacheBinary(out, cache, tags);
+    out.close();
+    printfQuda("Imported %lu sets of cached parameters from %s to %s\n", cache.size(), tsv_path.c_str(), bin_path.c_str());
+  }
+
+  void readTuneCache(const std::string &path, map &cache)
+  {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) errorQuda("Unable to open %s", path.c_str());
+    TuneCacheHeader header;
+    if (deserializeTuneCacheHeader(in, header)) {
+      tag_map tags;
+      deserializeTuneCacheBinary(in, cache, tags, header);
+    } else { // not a binary cache so try the TSV format instead
+      in.clear();
+      in.seekg(0);
+      if (!readTuneCacheHeaderTSV(in, header)) errorQuda("Bad format in %s", path.c_str());
+      deserializeTuneCache(in, cache);
+    }
+    in.close();
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Read %lu sets of cached parameters from %s (QUDA %s, %s)\n", cache.size(), path.c_str(),
+                 header.version.c_str(), header.hash.c_str());
+  }
+
+
   template <class T>
   struct less_significant : std::binary_function<T,T,bool> {
     inline bool operator()(const T &lhs, const T &rhs) {
@@ -287,10 +886,121 @@ namespace quda {
   }
 
 
+  /**
+     @brief Merge an entry into the tunecache, keeping the faster of
+     the two if the key is already present.  An entry from another
+     QUDA version only fills a missing key, while one from this
+     version always supersedes an unvalidated entry.  The profile
+     count of an existing entry is preserved.
+     @return Whether the entry was inserted or replaced
+   */
+  static bool mergeTuneEntry(const TuneKey &key, const TuneParam &param, const std::string &tag)
+  {
+    auto entry = tunecache.find(key);
+    if (entry == tunecache.end()) {
+      tunecache[key] = param;
+      tunecache[key].n_calls = 0;
+      setTuneEntryTag(key, tag);
+      return true;
+    } else if (tag == currentTuneEntryTag() && (tunecache_unverified.count(key) || param.time < entry->second.time)) {
+      long long n_calls = entry->second.n_calls;
+      entry->second = param;
+      entry->second.n_calls = n_calls;
+      tunecache_unverified.erase(key);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+     @brief Gather the entries newly tuned on each process onto
+     process 0 and merge them into its tunecache, keeping the fastest
+     entry for each key.  Processes are merged in rank order so that,
+     on equal times, the entry of the lowest rank is kept.  Process 0
+     adds those it did not already have to its journal so that they
+     are written out.  Must be called by all processes.
+     @param[out] sync Keys of the entries gathered on process 0, which
+     may differ between processes until they are redistributed
+   */
+  static void gatherTuneCache(std::set<TuneKey> &sync)
+  {
+#ifdef MULTI_GPU
+    std::stringstream serialized;
+    for (auto &key : tunecache_journal) serializeTuneEntry(serialized, key, tunecache[key], tuneEntryTag(key));
+    std::string local = serialized.str();
+
+    std::vector<uint64_t> sizes(comm_rank() == 0 ? comm_size() : 0);
+    uint64_t size = local.size();
+    comm_gather(&size, sizes.data(), sizeof(uint64_t));
+
+    uint64_t max_size = comm_rank() == 0 ? *std::max_element(sizes.begin(), sizes.end()) : 0;
+    comm_broadcast(&max_size, sizeof(uint64_t));
+
+    if (max_size > 0) {
+      // pad to the largest contribution so we can use a fixed-size gather
+      local.resize(max_size);
+      std::string remote(comm_rank() == 0 ? max_size * comm_size() : 0, '\0');
+      comm_gather(&local[0], comm_rank() == 0 ? &remote[0] : nullptr, max_size);
+
+      if (comm_rank() == 0) {
+	sync.insert(tunecache_journal.begin(), tunecache_journal.end());
+	for (int rank = 1; rank < comm_size(); rank++) {
+	  if (sizes[rank] == 0) continue;
+	  std::stringstream in(remote.substr(rank * max_size, sizes[rank]));
+	  map cache;
+	  tag_map tags;
+	  deserializeTuneCacheBinary(in, cache, tags);
+	  for (auto &entry : cache) {
+	    sync.insert(entry.first);
+	    if (mergeTuneEntry(entry.first, entry.second, tuneEntryTag(entry.first, tags)))
+	      tunecache_journal.insert(entry.first);
+	  }
+	}
+      }
+    }
+
+    // only rank 0 writes the cache
+    if (comm_rank() != 0) tunecache_journal.clear();
+#endif
+  }
+
+  /**
+     @brief Acquire an exclusive advisory lock on the given path,
+     waiting for up to the given time if another process holds it.
+     Unlike an O_EXCL lock file, the lock is released automatically
+     if the holder dies.
+     @return File descriptor of the lock (or -1 on failure)
+   */
+  static int lockFile(const std::string &lock_path, int timeout)
+  {
+    int lock_handle = open(lock_path.c_str(), O_WRONLY | O_CREAT, 0666);
+    if (lock_handle == -1) return -1;
+
+    for (int wait = 0; flock(lock_handle, LOCK_EX | LOCK_NB) != 0; wait++) {
+      if (wait >= timeout) {
+	close(lock_handle);
+	return -1;
+      }
+      sleep(1);
+    }
+    return lock_handle;
+  }
+
+  /** seconds to wait for another job to release the cache lock (QUDA_TUNECACHE_LOCK_TIMEOUT) */
+  static int tunecache_lock_timeout = getenv("QUDA_TUNECACHE_LOCK_TIMEOUT") ? atoi(getenv("QUDA_TUNECACHE_LOCK_TIMEOUT")) : 60;
+
+  static void unlockFile(int lock_handle)
+  {
+    flock(lock_handle, LOCK_UN);
+    close(lock_handle);
+  }
+
   /**
    * Distribute the tunecache from node 0 to all other nodes.
+   * @param[in] keys If given, only the entries of these keys (as
+   * known to node 0) are distributed
    */
-  static void broadcastTuneCache()
+  static void broadcastTuneCache(const std::set<TuneKey> *keys = nullptr)
   {
 #ifdef MULTI_GPU
 
@@ -298,7 +1008,16 @@ namespace quda {
     size_t size;
 
     if (comm_rank() == 0) {
-      serializeTuneCache(serialized);
+      if (keys) {
+	map cache;
+	for (auto &key : *keys) {
+	  auto entry = tunecache.find(key);
+	  if (entry != tunecache.end()) cache.insert(*entry);
+	}
+	serializeTuneCacheBinary(serialized, cache);
+      } else {
+	serializeTuneCacheBinary(serialized);
+      }
       size = serialized.str().length();
     }
     comm_broadcast(&size, sizeof(size_t));
@@ -307,12 +1026,13 @@ namespace quda {
       if (comm_rank() == 0) {
 	comm_broadcast(const_cast<char *>(serialized.str().c_str()), size);
       } else {
-	char *serstr = new char[size+1];
-	comm_broadcast(serstr, size);
-	serstr[size] ='\0'; // null-terminate
+	std::string serstr(size, '\0');
+	comm_broadcast(&serstr[0], size);
 	serialized.str(serstr);
-	deserializeTuneCache(serialized);
-	delete[] serstr;
+	map cache;
+	tag_map tags;
+	deserializeTuneCacheBinary(serialized, cache, tags);
+	adoptTuneCache(cache, tags);
       }
     }
 #endif
@@ -324,6 +1044,7 @@ namespace quda {
    */
   void loadTuneCache()
   {
+    TuneCacheWriteLock cache_lock;
     if (getTuning() == QUDA_TUNE_NO) {
       warningQuda("Autotuning disabled");
       return;
@@ -331,9 +1052,8 @@ namespace quda {
 
     char *path;
     struct stat pstat;
-    std::string cache_path, line, token;
+    std::string cache_path;
     std::ifstream cache_file;
-    std::stringstream ls;
 
     path = getenv("QUDA_RESOURCE_PATH");
 
@@ -353,45 +1073,49 @@ namespace quda {
     if (comm_rank() == 0) {
 #endif
 
-      cache_path = resource_path;
-      cache_path += "/tunecache.tsv";
-      cache_file.open(cache_path.c_str());
-
-      if (cache_file) {
-
-	if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-	getline(cache_file, line);
-	ls.str(line);
-	ls >> token;
-	if (token.compare("tunecache")) errorQuda("Bad format in %s", cache_path.c_str());
-	ls >> token;
-	if (token.compare(quda_version)) errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the QUDA_RESOURCE_PATH environment variable to point to a new path.", cache_path.c_str());
-	ls >> token;
-#ifdef GITVERSION
-	if (token.compare(gitversion)) errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the QUDA_RESOURCE_PATH environment variable to point to a new path.", cache_path.c_str());
-#else
-	if (token.compare(quda_version)) errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the QUDA_RESOURCE_PATH environment variable to point to a new path.", cache_path.c_str());
-#endif
-	ls >> token;
-	if (token.compare(quda_hash)) errorQuda("Cache file %s does not match current QUDA build. \nPlease delete this file or set the QUDA_RESOURCE_PATH environment variable to point to a new path.", cache_path.c_str());
-
-
-	if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-	getline(cache_file, line); // eat the blank line
+      TuneCacheHeader header;
+      map cache;
+      tag_map tags;
+
+      // prefer the binary cache, falling back to the legacy TSV cache if not present
+      if (!tuneCacheTSV()) {
+	cache_path = resource_path + "/tunecache.bin";
+	cache_file.open(cache_path.c_str(), std::ios::binary);
+	if (cache_file) {
+	  if (!deserializeTuneCacheHeader(cache_file, header)) errorQuda("Bad format in %s", cache_path.c_str());
+	  if (checkTuneCacheHeader(header, cache_path)) {
+	    tunecache_file_records = deserializeTuneCacheBinary(cache_file, cache, tags, header);
+	    tunecache_file_exists = true;
+	  }
+	  cache_file.close();
+	}
+      }
 
-	if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-	getline(cache_file, line); // eat the description line
+      if (!tunecache_file_exists) {
+	cache_path = resource_path + "/tunecache.tsv";
+	cache_file.open(cache_path.c_str());
+	if (cache_file) {
+	  if (!readTuneCacheHeaderTSV(cache_file, header)) errorQuda("Bad format in %s", cache_path.c_str());
+	  if (checkTuneCacheHeader(header, cache_path)) {
+	    deserializeTuneCache(cache_file, cache);
+	    if (tuneEntryTag(header) != currentTuneEntryTag())
+	      for (auto &entry : cache) tags[entry.first] = tuneEntryTag(header);
+	  }
+	  cache_file.close();
+	}
+      }
 
-	deserializeTuneCache(cache_file);
+      adoptTuneCache(cache, tags);
 
-	cache_file.close();
+      if (!tunecache.empty()) {
 	initial_cache_size = tunecache.size();
 
 	if (getVerbosity() >= QUDA_SUMMARIZE) {
 	  printfQuda("Loaded %d sets of cached parameters from %s\n", static_cast<int>(initial_cache_size), cache_path.c_str());
+	  if (tunecache_unverified.size() > 0)
+	    printfQuda("%d of these were tuned with a different QUDA version and will be validated on first use\n",
+		       static_cast<int>(tunecache_unverified.size()));
 	}
-
-
       } else {
 	warningQuda("Cache file not found.  All kernels will be re-tuned (if tuning is enabled).");
       }
@@ -406,67 +1130,166 @@ namespace quda {
 
 
   /**
-   * Write tunecache to disk.
+     @brief Read back the cache currently on disk, which may have been
+     updated by another job since we loaded it.
+     @param[out] cache The entries found on disk
+     @param[out] tags Version tags of entries from another QUDA version
+     @param[out] records Number of records in the file (binary only)
+     @return Whether a cache file matching this build was found
    */
-  void saveTuneCache(bool error)
+  static bool readDiskTuneCache(map &cache, tag_map &tags, size_t &records)
+  {
+    const TuneCacheHeader current = currentTuneCacheHeader();
+    TuneCacheHeader header;
+    records = 0;
+
+    if (tuneCacheTSV()) {
+      std::ifstream in((resource_path + "/tunecache.tsv").c_str());
+      if (!in || !readTuneCacheHeaderTSV(in, header) || header.hash != current.hash) return false;
+      deserializeTuneCache(in, cache);
+      if (tuneEntryTag(header) != currentTuneEntryTag())
+	for (auto &entry : cache) tags[entry.first] = tuneEntryTag(header);
+    } else {
+      std::ifstream in((resource_path + "/tunecache.bin").c_str(), std::ios::binary);
+      if (!in || !deserializeTuneCacheHeader(in, header) || header.hash != current.hash) return false;
+      records = deserializeTuneCacheBinary(in, cache, tags, header);
+    }
+    return true;
+  }
+
+  /**
+     @brief Write the tunecache of process 0 to disk, merging it with
+     whatever is currently on disk
+     @param[in] error Whether we are saving on the error path
+     @param[in,out] sync Keys of the entries that may differ between
+     processes, to which those adopted from disk are added
+   */
+  static void writeTuneCache(bool error, std::set<TuneKey> &sync)
   {
-    time_t now;
     int lock_handle;
     std::string lock_path, cache_path;
     std::ofstream cache_file;
 
-    if (resource_path.empty()) return;
-
-    //FIXME: We should really check to see if any nodes have tuned a kernel that was not also tuned on node 0, since as things
-    //       stand, the corresponding launch parameters would never get cached to disk in this situation.  This will come up if we
-    //       ever support different subvolumes per GPU (as might be convenient for lattice volumes that don't divide evenly).
-
-#ifdef MULTI_GPU
-    if (comm_rank() == 0) {
-#endif
+    if (tunecache_journal.empty() && !error) return;
 
-      if (tunecache.size() == initial_cache_size && !error) return;
-
-      // Acquire lock.  Note that this is only robust if the filesystem supports flock() semantics, which is true for
-      // NFS on recent versions of linux but not Lustre by default (unless the filesystem was mounted with "-o flock").
-      lock_path = resource_path + "/tunecache.lock";
-      lock_handle = open(lock_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
-      if (lock_handle == -1) {
-	warningQuda("Unable to lock cache file.  Tuned launch parameters will not be cached to disk.  "
-		    "If you are certain that no other instances of QUDA are accessing this filesystem, "
-		    "please manually remove %s", lock_path.c_str());
-	return;
-      }
-      char msg[] = "If no instances of applications using QUDA are running,\n"
-	"this lock file shouldn't be here and is safe to delete.";
-      int stat = write(lock_handle, msg, sizeof(msg)); // check status to avoid compiler warning
-      if (stat == -1) warningQuda("Unable to write to lock file for some bizarre reason");
+    // Acquire lock.  Note that this is only robust if the filesystem supports flock() semantics, which is true for
+    // NFS on recent versions of linux but not Lustre by default (unless the filesystem was mounted with "-o flock").
+    lock_path = resource_path + "/tunecache.lock";
+    lock_handle = lockFile(lock_path, error ? 0 : tunecache_lock_timeout);
+    if (lock_handle == -1) {
+      warningQuda("Unable to lock cache file %s.  Tuned launch parameters will not be cached to disk.", lock_path.c_str());
+      return;
+    }
 
-      cache_path = resource_path + (error ? "/tunecache_error.tsv" : "/tunecache.tsv");
+    if (error) {
+      cache_path = resource_path + "/tunecache_error.tsv";
       cache_file.open(cache_path.c_str());
 
       if (getVerbosity() >= QUDA_SUMMARIZE) {
 	printfQuda("Saving %d sets of cached parameters to %s\n", static_cast<int>(tunecache.size()), cache_path.c_str());
       }
 
-      time(&now);
-      cache_file << "tunecache\t" << quda_version;
-#ifdef GITVERSION
-       cache_file << "\t" << gitversion;
-#else
-       cache_file << "\t" << quda_version;
-#endif
-      cache_file << "\t" << quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
-      cache_file << std::setw(16) << "volume" << "\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\taux.x\taux.y\taux.z\taux.w\ttime\tcomment" << std::endl;
+      writeTuneCacheHeaderTSV(cache_file, currentTuneCacheHeader());
       serializeTuneCache(cache_file);
       cache_file.close();
+    } else {
+      // adopt anything written by other jobs, and only write out our entries if they are an improvement
+      map disk_cache;
+      tag_map disk_tags;
+      size_t disk_records;
+      tunecache_file_exists = readDiskTuneCache(disk_cache, disk_tags, disk_records);
+      tunecache_file_records = disk_records;
+
+      for (auto &entry : disk_cache)
+	if (mergeTuneEntry(entry.first, entry.second, tuneEntryTag(entry.first, disk_tags))) sync.insert(entry.first);
+      std::vector<TuneKey> updates;
+      for (auto &key : tunecache_journal) {
+	auto disk_entry = disk_cache.find(key);
+	if (disk_entry == disk_cache.end() || disk_tags.count(key) || tunecache[key].time < disk_entry->second.time)
+	  updates.push_back(key);
+      }
 
-      // Release lock.
-      close(lock_handle);
-      remove(lock_path.c_str());
+      if (tuneCacheTSV()) {
+	// the TSV format has no per-entry version, so only entries valid for this version are kept
+	map cache;
+	for (auto &entry : tunecache) if (!tunecache_unverified.count(entry.first)) cache.insert(entry);
+
+	cache_path = resource_path + "/tunecache.tsv";
+	cache_file.open(cache_path.c_str());
+
+	if (getVerbosity() >= QUDA_SUMMARIZE) {
+	  printfQuda("Saving %d sets of cached parameters to %s\n", static_cast<int>(cache.size()), cache_path.c_str());
+	}
+
+	writeTuneCacheHeaderTSV(cache_file, currentTuneCacheHeader());
+	serializeTuneCache(cache_file, cache);
+      } else {
+	cache_path = resource_path + "/tunecache.bin";
+	const bool compact = tunecache_file_records + updates.size() > 2 * tunecache.size();
+
+	if (!tunecache_file_exists || compact) {
+	  if (getVerbosity() >= QUDA_SUMMARIZE) {
+	    printfQuda("Saving %d sets of cached parameters to %s\n", static_cast<int>(tunecache.size()), cache_path.c_str());
+	  }
+	  cache_file.open(cache_path.c_str(), std::ios::binary | std::ios::trunc);
+	  serializeTuneCacheHeader(cache_file, currentTuneCacheHeader());
+	  serializeTuneCacheBinary(cache_file);
+	  tunecache_file_records = tunecache.size();
+	} else if (updates.size() > 0) {
+	  if (getVerbosity() >= QUDA_SUMMARIZE) {
+	    printfQuda("Appending %d sets of cached parameters to %s\n", static_cast<int>(updates.size()), cache_path.c_str());
+	  }
+	  cache_file.open(cache_path.c_str(), std::ios::binary | std::ios::app);
+	  for (auto &key : updates) serializeTuneEntry(cache_file, key, tunecache[key], tuneEntryTag(key));
+	  tunecache_file_records += updates.size();
+	}
+      }
+      if (cache_file.is_open()) cache_file.close();
+      tunecache_file_exists = true;
+      tunecache_journal.clear();
+    }
+
+    // Release lock.
+    unlockFile(lock_handle);
+
+    initial_cache_size = tunecache.size();
+  }
+
+  /**
+   * Write tunecache to disk.  Entries tuned on any process are first
+   * gathered to process 0, which then merges them with whatever is
+   * currently on disk (another job may have written to the cache
+   * since it was loaded), keeping the fastest entry for each key.
+   * The merged entries are then redistributed from process 0, so
+   * that all processes launch with the same parameters.  With the
+   * binary format only the entries tuned since the last save are
+   * appended to the file, unless the file does not yet exist or has
+   * accumulated enough superseded records that it is worth compacting
+   * it.
+   */
+  void saveTuneCache(bool error)
+  {
+    TuneCacheWriteLock cache_lock;
+
+    if (resource_path.empty()) return;
+
+    if (!error && tunecache_invalidated.size() > 0) {
+      if (getVerbosity() >= QUDA_SUMMARIZE) {
+	printfQuda("Invalidated %d cached parameter sets tuned with a different QUDA version:\n",
+		   static_cast<int>(tunecache_invalidated.size()));
+	for (auto &key : tunecache_invalidated) printfQuda("  %s with %s at vol=%s\n", key.name, key.aux, key.volume);
+      }
+      tunecache_invalidated.clear();
+    }
 
-      initial_cache_size = tunecache.size();
+    // collective, so not possible on the error path which may only be hit on a single process
+    std::set<TuneKey> sync;
+    if (!error) gatherTuneCache(sync);
 
+#ifdef MULTI_GPU
+    if (comm_rank() == 0) {
+#endif
+      writeTuneCache(error, sync);
 #ifdef MULTI_GPU
     } else {
       // give process 0 time to write out its tunecache if needed, but
@@ -474,9 +1297,11 @@ namespace quda {
       if (error) sleep(10);
     }
 #endif
+
+    if (!error) broadcastTuneCache(&sync);
   }
 
-  static bool policy_tuning = false;
+  static thread_local bool policy_tuning = false;
   bool policyTuning() {
     return policy_tuning;
   }
@@ -488,6 +1313,7 @@ namespace quda {
   // flush profile, setting counts to zero
   void flushProfile()
   {
+    TuneCacheWriteLock cache_lock;
     for (map::iterator entry = tunecache.begin(); entry != tunecache.end(); entry++) {
       // set all n_calls = 0
       TuneParam &param = entry->second;
@@ -495,9 +1321,33 @@ namespace quda {
     }
   }
 
+  void saveLaunchTrace()
+  {
+    std::lock_guard<std::mutex> trace_lock(trace_mutex);
+    if (resource_path.empty() || launch_trace_count == 0) return;
+
+    char *profile_fname = getenv("QUDA_PROFILE_OUTPUT_BASE");
+    std::string path = resource_path + "/" + (profile_fname ? std::string(profile_fname) + "_" : std::string(""))
+      + "launch_trace_" + std::to_string(comm_rank()) + ".csv";
+
+    std::ofstream file(path.c_str());
+    if (!file.good()) {
+      warningQuda("Unable to open launch trace file %s", path.c_str());
+      return;
+    }
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      size_t n = std::min(launch_trace_count, launch_trace.size());
+      printfQuda("Saving launch trace with %lu of %lu entries to %s\n", n, launch_trace_count, path.c_str());
+    }
+    serializeLaunchTrace(file);
+    file.close();
+  }
+
   // save profile
   void saveProfile(const std::string label)
   {
+    TuneCacheWriteLock cache_lock;
     time_t now;
     int lock_handle;
     std::string lock_path, profile_path, async_profile_path, trace_path;
@@ -505,6 +1355,9 @@ namespace quda {
 
     if (resource_path.empty()) return;
 
+    // every process writes its own launch trace
+    if (traceEnabled() >= 2) saveLaunchTrace();
+
 #ifdef MULTI_GPU
     if (comm_rank() == 0) {
 #endif
@@ -605,7 +1458,10 @@ namespace quda {
         trace_file << std::setw(12) << "mapped-mem\t" << std::setw(12) << "host-mem\t";
         trace_file << std::setw(16) << "volume" << "\tname\taux" << std::endl;
 
-        serializeTrace(trace_file);
+        {
+          std::lock_guard<std::mutex> trace_lock(trace_mutex);
+          serializeTrace(trace_file);
+        }
 
         trace_file.close();
       }
@@ -621,77 +1477,172 @@ namespace quda {
 
   static TimeProfile launchTimer("tuneLaunch");
 
-//  static int tally = 0;
+  /**
+     @brief Check that a cached launch parameter is still one the
+     tunable would consider, i.e., that it lies in the present tuning
+     space.  This is deterministic and launches nothing, so all
+     processes reach the same conclusion.
+   */
+  static bool validTuneParam(Tunable &tunable, const TuneParam &cached)
+  {
+    TuneParam param;
+    tunable.initTuneParam(param);
+    do {
+      if (param.block.x == cached.block.x && param.block.y == cached.block.y && param.block.z == cached.block.z &&
+	  param.grid.x == cached.grid.x && param.grid.y == cached.grid.y && param.grid.z == cached.grid.z &&
+	  param.shared_bytes == cached.shared_bytes && param.aux.x == cached.aux.x && param.aux.y == cached.aux.y &&
+	  param.aux.z == cached.aux.z && param.aux.w == cached.aux.w) return true;
+    } while (tunable.advanceTuneParam(param));
+    return false;
+  }
+
+  /**
+     @brief Validate a cached entry tuned with another QUDA version,
+     discarding it if it no longer lies in the tunable's tuning space.
+     Must be called with the tunecache locked for writing.
+   */
+  static void verifyTuneEntry(Tunable &tunable, const TuneKey &key, uint64_t hash, QudaVerbosity verbosity)
+  {
+    auto unverified = tunecache_unverified.find(key);
+    if (unverified == tunecache_unverified.end()) return; // another thread got here first
+    auto entry = tunecache.find(key);
+    if (entry != tunecache.end()) {
+      if (validTuneParam(tunable, entry->second)) {
+	tunecache_journal.insert(key); // rewrite with the present version
+      } else {
+	if (verbosity >= QUDA_VERBOSE)
+	  printfQuda("Discarding cached %s for %s with %s tuned with QUDA %s\n", tunable.paramString(entry->second).c_str(),
+		     key.name, key.aux, unverified->second.c_str());
+	tunecache_invalidated.push_back(key);
+	tunecache_index.erase(hash);
+	tunecache.erase(entry);
+      }
+    }
+    tunecache_unverified.erase(unverified);
+  }
+
+  /**
+     @brief Look up a key for launching and copy its launch parameters.
+     Runs with the tunecache locked for reading; the call count of the
+     entry is updated atomically since other readers may be doing the
+     same.
+     @param[out] param Launch parameters of the entry, if found
+     @param[out] unverified Whether the entry must be validated first
+     @param[out] indexed Whether the entry was found in the hashed index
+     @return Whether the key was found
+   */
+  static bool lookupTuneEntry(const TuneKey &key, uint64_t hash, TuneParam &param, bool &unverified, bool &indexed)
+  {
+    TuneCacheReadLock lock;
+    auto entry = findTuneEntry(key, hash, indexed);
+    if (entry == tunecache.end()) return false;
+    unverified = !tuning && tunecache_unverified.size() > 0 && tunecache_unverified.count(key);
+    if (unverified) return true;
+
+    param.block = entry->second.block;
+    param.grid = entry->second.grid;
+    param.shared_bytes = entry->second.shared_bytes;
+    param.aux = entry->second.aux;
+    param.time = entry->second.time;
+    // we could be tuning outside of the current scope
+    if (!tuning && profile_count) __atomic_fetch_add(&entry->second.n_calls, 1, __ATOMIC_RELAXED);
+    param.n_calls = __atomic_load_n(&entry->second.n_calls, __ATOMIC_RELAXED);
+    return true;
+  }
+
+  /**
+     @brief Record a launch in the kernel trace and launch trace
+     @param[in] list Whether to also append the launch to the kernel trace list
+   */
+  static void traceLaunch(const TuneKey &key, const TuneParam &param, long long flops, long long bytes, bool list)
+  {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (list) trace_list.push_back(TraceKey(key, param.time));
+    postLaunchTrace(key, param, flops, bytes);
+  }
 
   /**
    * Return the optimal launch parameters for a given kernel, either
    * by retrieving them from tunecache or autotuning on the spot.
+   *
+   * This may be called concurrently from several host threads.
+   * Cached kernels are looked up under a shared lock and their
+   * parameters returned through a thread-local copy.  Tuning is
+   * serialized: a single thread tunes at any one time, and the
+   * tuning state (the active tunable and its parameters) is kept per
+   * thread.  When another thread is already tuning, a process that
+   * tunes independently (global reductions disabled) launches with
+   * the default parameters rather than wait, and tunes the kernel on
+   * a later launch.  Otherwise tuning involves collective
+   * communication, so the thread waits its turn.  All processes must
+   * then issue their tuning launches in the same order, exactly as
+   * in the single-threaded case.
    */
   TuneParam& tuneLaunch(Tunable &tunable, QudaTune enabled, QudaVerbosity verbosity)
   {
-#ifdef PTHREADS // tuning should be performed serially
-//  pthread_mutex_lock(&pthread_mutex);
-//  tally++;
-#endif
-
 #ifdef LAUNCH_TIMER
     launchTimer.TPSTART(QUDA_PROFILE_TOTAL);
     launchTimer.TPSTART(QUDA_PROFILE_INIT);
 #endif
 
     const TuneKey key = tunable.tuneKey();
+    const uint64_t hash = hashTuneKey(key);
     last_key = key;
-    static TuneParam param;
+    static thread_local TuneParam param;        // parameters of the kernel this thread is tuning
+    static thread_local TuneParam launch_param; // parameters of a cached kernel
+    static thread_local const Tunable *active_tunable; // for error checking
 
 #ifdef LAUNCH_TIMER
     launchTimer.TPSTOP(QUDA_PROFILE_INIT);
     launchTimer.TPSTART(QUDA_PROFILE_PREAMBLE);
 #endif
 
-    static const Tunable *active_tunable; // for error checking
-    it = tunecache.find(key);
-
     // first check if we have the tuned value and return if we have it
-    if (enabled == QUDA_TUNE_YES && it != tunecache.end()) {
+    if (enabled == QUDA_TUNE_YES) {
+      bool unverified = false, indexed = true;
+      bool found = lookupTuneEntry(key, hash, launch_param, unverified, indexed);
 
-#ifdef LAUNCH_TIMER
-      launchTimer.TPSTOP(QUDA_PROFILE_PREAMBLE);
-      launchTimer.TPSTART(QUDA_PROFILE_COMPUTE);
-#endif
-
-      TuneParam &param = it->second;
+      if (found && !indexed) {
+	TuneCacheWriteLock lock;
+	indexTuneEntry(key, hash);
+      }
 
-      if (verbosity >= QUDA_DEBUG_VERBOSE) {
-        printfQuda("Launching %s with %s at vol=%s with %s\n",
-                   key.name, key.aux, key.volume, tunable.paramString(param).c_str());
+      // entries tuned with another QUDA version must be validated before their first use
+      if (found && unverified) {
+	{
+	  TuneCacheWriteLock lock;
+	  verifyTuneEntry(tunable, key, hash, verbosity);
+	}
+	found = lookupTuneEntry(key, hash, launch_param, unverified, indexed);
       }
 
+      if (found) {
 #ifdef LAUNCH_TIMER
-      launchTimer.TPSTOP(QUDA_PROFILE_COMPUTE);
-      launchTimer.TPSTART(QUDA_PROFILE_EPILOGUE);
+	launchTimer.TPSTOP(QUDA_PROFILE_PREAMBLE);
+	launchTimer.TPSTART(QUDA_PROFILE_COMPUTE);
 #endif
 
-      tunable.checkLaunchParam(param);
+	if (verbosity >= QUDA_DEBUG_VERBOSE) {
+	  printfQuda("Launching %s with %s at vol=%s with %s\n",
+		     key.name, key.aux, key.volume, tunable.paramString(launch_param).c_str());
+	}
 
-#ifdef PTHREADS
-      //pthread_mutex_unlock(&pthread_mutex);
-      //tally--;
-      //printfQuda("pthread_mutex_unlock a complete %d\n",tally);
+#ifdef LAUNCH_TIMER
+	launchTimer.TPSTOP(QUDA_PROFILE_COMPUTE);
+	launchTimer.TPSTART(QUDA_PROFILE_EPILOGUE);
 #endif
-      // we could be tuning outside of the current scope
-      if (!tuning && profile_count) param.n_calls++;
+
+	tunable.checkLaunchParam(launch_param);
 
 #ifdef LAUNCH_TIMER
-      launchTimer.TPSTOP(QUDA_PROFILE_EPILOGUE);
-      launchTimer.TPSTOP(QUDA_PROFILE_TOTAL);
+	launchTimer.TPSTOP(QUDA_PROFILE_EPILOGUE);
+	launchTimer.TPSTOP(QUDA_PROFILE_TOTAL);
 #endif
 
-      if (traceEnabled() >= 2) {
-        TraceKey trace_entry(key, param.time);
-        trace_list.push_back(trace_entry);
-      }
+	if (traceEnabled() >= 2) traceLaunch(key, launch_param, tunable.flops(), tunable.bytes(), true);
 
-      return param;
+	return launch_param;
+      }
     }
 
 #ifdef LAUNCH_TIMER
@@ -699,7 +1650,26 @@ namespace quda {
     launchTimer.TPSTOP(QUDA_PROFILE_TOTAL);
 #endif
 
-    if (enabled == QUDA_TUNE_NO) {
+    std::unique_lock<std::mutex> tuner(tuner_mutex, std::defer_lock);
+    bool use_default = enabled == QUDA_TUNE_NO;
+    if (enabled == QUDA_TUNE_YES && !tuning) {
+      if (commGlobalReduction() || policyTuning()) {
+	tuner.lock();
+      } else if (!tuner.try_lock()) {
+	if (verbosity >= QUDA_DEBUG_VERBOSE) printfQuda("Another thread is tuning, deferring tuning of %s\n", key.name);
+	use_default = true;
+      }
+
+      // another thread may have tuned this kernel while we waited
+      bool unverified, indexed;
+      if (tuner.owns_lock() && lookupTuneEntry(key, hash, launch_param, unverified, indexed) && !unverified) {
+	if (traceEnabled() >= 2) traceLaunch(key, launch_param, tunable.flops(), tunable.bytes(), true);
+	return launch_param;
+      }
+    }
+
+    if (use_default) {
+      TuneParam &param = launch_param;
       tunable.defaultTuneParam(param);
       tunable.checkLaunchParam(param);
 
@@ -707,6 +1677,10 @@ namespace quda {
         printfQuda("Launching %s with %s at vol=%s with %s (untuned)\n",
                    key.name, key.aux, key.volume, tunable.paramString(param).c_str());
       }
+
+      if (traceEnabled() >= 2) traceLaunch(key, param, tunable.flops(), tunable.bytes(), false);
+      param.n_calls = profile_count ? 1 : 0;
+      return param;
     } else if (!tuning) {
 
       /* As long as global reductions are not disabled, only do the
@@ -812,32 +1786,30 @@ namespace quda {
 	if (verbosity >= QUDA_DEBUG_VERBOSE) printfQuda("PostTune %s\n", key.name);
 	tunable.postTune();
 	param = best_param;
-	tunecache[key] = best_param;
 
+	TuneCacheWriteLock lock;
+	tunecache[key] = best_param;
+	tunecache_journal.insert(key);
       }
-      if (commGlobalReduction() || policyTuning()) broadcastTuneCache();
 
-      // check this process is getting the key that is expected
-      if (tunecache.find(key) == tunecache.end()) {
-	errorQuda("Failed to find key entry (%s:%s:%s)", key.name, key.volume, key.aux);
-      }
-      param = tunecache[key]; // read this now for all processes
+      {
+	TuneCacheWriteLock lock;
+	if (commGlobalReduction() || policyTuning()) broadcastTuneCache();
 
-      if (traceEnabled() >= 2) {
-        TraceKey trace_entry(key, param.time);
-        trace_list.push_back(trace_entry);
+	// check this process is getting the key that is expected
+	auto entry = tunecache.find(key);
+	if (entry == tunecache.end()) {
+	  errorQuda("Failed to find key entry (%s:%s:%s)", key.name, key.volume, key.aux);
+	}
+	param = entry->second; // read this now for all processes
       }
 
+      if (traceEnabled() >= 2) traceLaunch(key, param, tunable.flops(), tunable.bytes(), true);
+
     } else if (&tunable != active_tunable) {
       errorQuda("Unexpected call to tuneLaunch() in %s::apply()", typeid(tunable).name());
     }
 
-#ifdef PTHREADS
-//    pthread_mutex_unlock(&pthread_mutex);
-//    tally--;
-//    printfQuda("pthread_mutex_unlock b complete %d\n",tally);
-#endif
-
     param.n_calls = profile_count ? 1 : 0;
 
     return param;
@@ -5,6 +5,7 @@
 template <typename Float>
 inline void aXpY(Float a, Float *x, Float *y, int len)
 {
+#pragma omp parallel for
   for(int i=0; i < len; i++){ y[i] += a*x[i]; }
 }
 
@@ -16,6 +17,7 @@ void axpy(double a, void *x, void *y, int len, QudaPrecision precision) {
 // performs the operation x[i] *= a
 template <typename Float>
 inline void aX(Float a, Float *x, int len) {
+#pragma omp parallel for
   for (int i=0; i<len; i++) x[i] *= a;
 }
 
@@ -27,6 +29,7 @@ void ax(double a, void *x, int len, QudaPrecision precision) {
 // performs the operation y[i] -= x[i] (minus x plus y)
 template <typename Float>
 inline void mXpY(Float *x, Float *y, int len) {
+#pragma omp parallel for
   for (int i=0; i<len; i++) y[i] -= x[i];
 }
 
@@ -53,6 +56,7 @@ double norm_2(void *v, int len, QudaPrecision precision) {
 // performs the operation y[i] = x[i] + a*y[i]
 template <typename Float>
 static inline void xpay(Float *x, Float a, Float *y, int len) {
+#pragma omp parallel for
   for (int i=0; i<len; i++) y[i] = x[i] + a*y[i];
 }
 
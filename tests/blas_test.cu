@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
 
 #include <quda_internal.h>
 #include <color_spinor_field.h>
@@ -907,6 +908,46 @@ const char *prec_str[] = {"quarter", "half", "single", "double"};
 
 // For googletest names must be non-empty, unique, and may only contain ASCII
 // alphanumeric characters or underscore
+/**
+   Check the host blas and reductions on half and quarter precision
+   (block-float) fields against double precision.  The reference is
+   computed from the quantized inputs, so that only the error of the
+   low-precision kernels is measured.
+   @return Largest relative deviation from the double-precision result
+ */
+double hostBlockFloatTest(QudaPrecision precision) {
+
+  ColorSpinorParam param(*xH);
+  param.create = QUDA_NULL_FIELD_CREATE;
+
+  // half and quarter fields are converted to and from through single precision
+  param.setPrecision(QUDA_SINGLE_PRECISION);
+  cpuColorSpinorField tmp(param);
+  param.setPrecision(precision);
+  cpuColorSpinorField x(param), y(param);
+  param.setPrecision(QUDA_DOUBLE_PRECISION);
+  cpuColorSpinorField x_ref(param), y_ref(param), y_out(param);
+
+  tmp = *xH; x = tmp; tmp = x; x_ref = tmp;
+  tmp = *yH; y = tmp; tmp = y; y_ref = tmp;
+
+  double error = 0;
+
+  // genericReduce
+  double x2 = blas::norm2(x_ref), y2 = blas::norm2(y_ref);
+  error = std::max(error, fabs(blas::norm2(x) - x2) / x2);
+  error = std::max(error, abs(blas::cDotProduct(x, y) - blas::cDotProduct(x_ref, y_ref)) / sqrt(x2*y2));
+
+  // genericBlas, whose result is quantized again on output
+  blas::axpby(M_PI, x, -exp(1.0), y);
+  blas::axpby(M_PI, x_ref, -exp(1.0), y_ref);
+  tmp = y; y_out = tmp;
+  blas::axpy(-1.0, y_ref, y_out);
+  error = std::max(error, sqrt(blas::norm2(y_out) / blas::norm2(y_ref)));
+
+  return error;
+}
+
 const char *names[] = {
   "copyHS",
   "copyMS",
@@ -1056,6 +1097,21 @@ TEST_P(BlasTest, benchmark) {
 }
 
 
+// host half (1) and quarter (0) precision fields
+class HostBlockFloatTest : public ::testing::TestWithParam<int> {
+public:
+  virtual ~HostBlockFloatTest() { }
+  virtual void SetUp() { initFields(GetParam()); }
+  virtual void TearDown() { freeFields(); }
+};
+
+TEST_P(HostBlockFloatTest, verify) {
+  int prec = GetParam();
+  double deviation = hostBlockFloatTest(prec == 1 ? QUDA_HALF_PRECISION : QUDA_QUARTER_PRECISION);
+  double tol = (prec == 1 ? 1e-3 : 1e-1);
+  EXPECT_LE(deviation, tol) << "Host block-float and double-precision implementations do not agree";
+}
+
 std::string getblasname(testing::TestParamInfo<::testing::tuple<int, int>> param){
    int prec = ::testing::get<0>(param.param);
    int kernel = ::testing::get<1>(param.param);
@@ -1065,5 +1121,10 @@ std::string getblasname(testing::TestParamInfo<::testing::tuple<int, int>> param
    return str;//names[kernel] + "_" + prec_str[prec];
 }
 
+std::string gethostblockfloatname(testing::TestParamInfo<int> param){
+   return std::string("host_") + std::string(prec_str[param.param]);
+}
+
 // instantiate all test cases
 INSTANTIATE_TEST_CASE_P(QUDA, BlasTest, Combine( Range(0,4), Range(0, Nkernels) ), getblasname);
+INSTANTIATE_TEST_CASE_P(QUDA, HostBlockFloatTest, Range(0,2), gethostblockfloatname);
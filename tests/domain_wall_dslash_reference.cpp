@@ -29,21 +29,8 @@ int neighborIndex_4d(int i, int oddBit, int dx4, int dx3, int dx2, int dx1) {
   // On input i should be in the range [0 , ... , Z[0]*Z[1]*Z[2]*Z[3]/2-1].
   if (i < 0 || i >= (Z[0]*Z[1]*Z[2]*Z[3]/2))
     { printf("i out of range in neighborIndex_4d\n"); exit(-1); }
-  // Compute the linear index.  Then dissect.
-  // fullLatticeIndex_4d is in util_quda.cpp.
   // The gauge fields live on a 4d sublattice.
-  int X = fullLatticeIndex_4d(i, oddBit);
-  int x4 = X/(Z[2]*Z[1]*Z[0]);
-  int x3 = (X/(Z[1]*Z[0])) % Z[2];
-  int x2 = (X/Z[0]) % Z[1];
-  int x1 = X % Z[0];
-
-  x4 = (x4+dx4+Z[3]) % Z[3];
-  x3 = (x3+dx3+Z[2]) % Z[2];
-  x2 = (x2+dx2+Z[1]) % Z[1];
-  x1 = (x1+dx1+Z[0]) % Z[0];
-
-  return (x4*(Z[2]*Z[1]*Z[0]) + x3*(Z[1]*Z[0]) + x2*(Z[0]) + x1) / 2;
+  return neighborIndex(i, oddBit, dx4, dx3, dx2, dx1);
 }
 
 
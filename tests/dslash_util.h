@@ -37,6 +37,7 @@ static inline void axpby(Float a, Float *x, Float b, Float *y, int len) {
 // performs the operation y[i] = a*x[i] - y[i]
 template <typename Float>
 static inline void axmy(Float *x, Float a, Float *y, int len) {
+#pragma omp parallel for
   for (int i=0; i<len; i++) y[i] = a*x[i] - y[i];
 }
 
@@ -89,6 +90,27 @@ static inline void su3Tmul(sFloat *res, gFloat *mat, sFloat *vec) {
 }
 
 
+/**
+   @brief Return the address of a neighbouring site given its entry in
+   a neighborTable
+   @param[in] n The neighbour
+   @param[in] field The local (body) field
+   @param[in] fwd Forward ghost zones (only used if the neighbour is in one)
+   @param[in] back Backward ghost zones (only used if the neighbour is in one)
+   @param[in] siteSize Number of reals per site
+   @param[in] s Fifth-dimension (or source) index of the site, for
+   fields and tables with Ls > 1
+ */
+template <typename Float>
+static inline Float *neighborSite(const LatticeNeighbor &n, Float *field, Float **fwd, Float **back, int siteSize, int s = 0)
+{
+  if (n.region == LatticeNeighbor::BODY) return &field[(s * Vh + n.index) * siteSize];
+  const int d = n.region < LatticeNeighbor::BACKWARD_GHOST ? n.region - LatticeNeighbor::FORWARD_GHOST :
+    n.region - LatticeNeighbor::BACKWARD_GHOST;
+  Float *base = n.region < LatticeNeighbor::BACKWARD_GHOST ? fwd[d] : back[d];
+  return &base[(s * (faceVolume[d] / 2) + n.index) * siteSize];
+}
+
 // i represents a "half index" into an even or odd "half lattice".
 // when oddBit={0,1} the half lattice is {even,odd}.
 // 
@@ -158,22 +180,16 @@ template<QudaDWFPCType type>
 int neighborIndex_5d(int i, int oddBit, int dxs, int dx4, int dx3, int dx2, int dx1) {
   // fullLatticeIndex was modified for fullLatticeIndex_4d.  It is in util_quda.cpp.
   // This code bit may not properly perform 5dPC.
-  int X = type == QUDA_5D_PC ? fullLatticeIndex_5d(i, oddBit) : fullLatticeIndex_5d_4dpc(i, oddBit);
-  // Checked that this matches code in dslash_core_ante.h.
-  int xs = X/(Z[3]*Z[2]*Z[1]*Z[0]);
-  int x4 = (X/(Z[2]*Z[1]*Z[0])) % Z[3];
-  int x3 = (X/(Z[1]*Z[0])) % Z[2];
-  int x2 = (X/Z[0]) % Z[1];
-  int x1 = X % Z[0];
+  int x[5];
+  latticeGeometry(Z, Ls).coords5d(x, i, oddBit, type);
+  int xs = x[4], x4 = x[3], x3 = x[2], x2 = x[1], x1 = x[0];
   // Displace and project back into domain 0,...,Ls-1.
-  // Note that we add Ls to avoid the negative problem
-  // of the C % operator.
-  xs = (xs+dxs+Ls) % Ls;
+  xs = LatticeGeometry::wrap(xs+dxs, Ls);
   // Etc.
-  x4 = (x4+dx4+Z[3]) % Z[3];
-  x3 = (x3+dx3+Z[2]) % Z[2];
-  x2 = (x2+dx2+Z[1]) % Z[1];
-  x1 = (x1+dx1+Z[0]) % Z[0];
+  x4 = LatticeGeometry::wrap(x4+dx4, Z[3]);
+  x3 = LatticeGeometry::wrap(x3+dx3, Z[2]);
+  x2 = LatticeGeometry::wrap(x2+dx2, Z[1]);
+  x1 = LatticeGeometry::wrap(x1+dx1, Z[0]);
   // Return linear half index.  Remember that integer division
   // rounds down.
   return (xs*(Z[3]*Z[2]*Z[1]*Z[0]) + x4*(Z[2]*Z[1]*Z[0]) + x3*(Z[1]*Z[0]) + x2*(Z[0]) + x1) / 2;
@@ -205,9 +221,7 @@ template <QudaDWFPCType type, typename Float>
 
 inline int x4_mg(int i, int oddBit)
 {
-  int Y = fullLatticeIndex(i, oddBit);
-  int x4 = Y/(Z[2]*Z[1]*Z[0]);
-  return x4;
+  return latticeGeometry(Z).coords(i, oddBit)[3];
 }
 
 template <typename Float>
@@ -222,11 +236,8 @@ static inline Float *gaugeLink_mg4dir(int i, int dir, int oddBit, Float **gaugeE
   }
   else {
 
-    int Y = fullLatticeIndex(i, oddBit);
-    int x4 = Y/(Z[2]*Z[1]*Z[0]);
-    int x3 = (Y/(Z[1]*Z[0])) % Z[2];
-    int x2 = (Y/Z[0]) % Z[1];
-    int x1 = Y % Z[0];
+    const int *x = latticeGeometry(Z).coords(i, oddBit);
+    int x4 = x[3], x3 = x[2], x2 = x[1], x1 = x[0];
     int X1= Z[0];
     int X2= Z[1];
     int X3= Z[2];
@@ -236,7 +247,7 @@ static inline Float *gaugeLink_mg4dir(int i, int dir, int oddBit, Float **gaugeE
     switch (dir) {
     case 1:
       { //-X direction
-        int new_x1 = (x1 - d + X1 )% X1;
+        int new_x1 = LatticeGeometry::wrap(x1 - d, X1);
         if (x1 -d < 0 && comm_dim_partitioned(0)){
 	  ghostGaugeField = (oddBit?ghostGaugeEven[0]: ghostGaugeOdd[0]);
 	  int offset = (n_ghost_faces + x1 -d)*X4*X3*X2/2 + (x4*X3*X2 + x3*X2+x2)/2;
@@ -247,7 +258,7 @@ static inline Float *gaugeLink_mg4dir(int i, int dir, int oddBit, Float **gaugeE
       }
     case 3:
       { //-Y direction
-        int new_x2 = (x2 - d + X2 )% X2;
+        int new_x2 = LatticeGeometry::wrap(x2 - d, X2);
         if (x2 -d < 0 && comm_dim_partitioned(1)){
           ghostGaugeField = (oddBit?ghostGaugeEven[1]: ghostGaugeOdd[1]);
           int offset = (n_ghost_faces + x2 -d)*X4*X3*X1/2 + (x4*X3*X1 + x3*X1+x1)/2;
@@ -259,7 +270,7 @@ static inline Float *gaugeLink_mg4dir(int i, int dir, int oddBit, Float **gaugeE
       }
     case 5:
       { //-Z direction
-        int new_x3 = (x3 - d + X3 )% X3;
+        int new_x3 = LatticeGeometry::wrap(x3 - d, X3);
         if (x3 -d < 0 && comm_dim_partitioned(2)){
           ghostGaugeField = (oddBit?ghostGaugeEven[2]: ghostGaugeOdd[2]);
           int offset = (n_ghost_faces + x3 -d)*X4*X2*X1/2 + (x4*X2*X1 + x2*X1+x1)/2;
@@ -270,7 +281,7 @@ static inline Float *gaugeLink_mg4dir(int i, int dir, int oddBit, Float **gaugeE
       }
     case 7:
       { //-T direction
-        int new_x4 = (x4 - d + X4)% X4;
+        int new_x4 = LatticeGeometry::wrap(x4 - d, X4);
         if (x4 -d < 0 && comm_dim_partitioned(3)){
           ghostGaugeField = (oddBit?ghostGaugeEven[3]: ghostGaugeOdd[3]);
           int offset = (n_ghost_faces + x4 -d)*X1*X2*X3/2 + (x3*X2*X1 + x2*X1+x1)/2;
@@ -295,11 +306,8 @@ static inline Float *spinorNeighbor_mg4dir(int i, int dir, int oddBit, Float *sp
 {
   int j;
   int nb = neighbor_distance;
-  int Y = fullLatticeIndex(i, oddBit);
-  int x4 = Y/(Z[2]*Z[1]*Z[0]);
-  int x3 = (Y/(Z[1]*Z[0])) % Z[2];
-  int x2 = (Y/Z[0]) % Z[1];
-  int x1 = Y % Z[0];
+  const int *x = latticeGeometry(Z).coords(i, oddBit);
+  int x4 = x[3], x3 = x[2], x2 = x[1], x1 = x[0];
   int X1= Z[0];
   int X2= Z[1];
   int X3= Z[2];
@@ -308,7 +316,7 @@ static inline Float *spinorNeighbor_mg4dir(int i, int dir, int oddBit, Float *sp
   switch (dir) {
   case 0://+X
     {
-      int new_x1 = (x1 + nb)% X1;
+      int new_x1 = LatticeGeometry::wrap(x1 + nb, X1);
       if(x1+nb >=X1 && comm_dim_partitioned(0) ){
         int offset = ( x1 + nb -X1)*X4*X3*X2/2+(x4*X3*X2 + x3*X2+x2)/2;
         return fwd_nbr_spinor[0] + offset*mySpinorSiteSize;
@@ -318,7 +326,7 @@ static inline Float *spinorNeighbor_mg4dir(int i, int dir, int oddBit, Float *sp
     }
   case 1://-X
     {
-      int new_x1 = (x1 - nb + X1)% X1;
+      int new_x1 = LatticeGeometry::wrap(x1 - nb, X1);
       if(x1 - nb < 0 && comm_dim_partitioned(0)){
         int offset = ( x1+nFace- nb)*X4*X3*X2/2+(x4*X3*X2 + x3*X2+x2)/2;
         return back_nbr_spinor[0] + offset*mySpinorSiteSize;
@@ -328,7 +336,7 @@ static inline Float *spinorNeighbor_mg4dir(int i, int dir, int oddBit, Float *sp
     }
   case 2://+Y
     {
-      int new_x2 = (x2 + nb)% X2;
+      int new_x2 = LatticeGeometry::wrap(x2 + nb, X2);
       if(x2+nb >=X2 && comm_dim_partitioned(1)){
         int offset = ( x2 + nb -X2)*X4*X3*X1/2+(x4*X3*X1 + x3*X1+x1)/2;
         return fwd_nbr_spinor[1] + offset*mySpinorSiteSize;
@@ -338,7 +346,7 @@ static inline Float *spinorNeighbor_mg4dir(int i, int dir, int oddBit, Float *sp
     }
   case 3:// -Y
     {
-      int new_x2 = (x2 - nb + X2)% X2;
+      int new_x2 = LatticeGeometry::wrap(x2 - nb, X2);
       if(x2 - nb < 0 && comm_dim_partitioned(1)){
         int offset = ( x2 + nFace -nb)*X4*X3*X1/2+(x4*X3*X1 + x3*X1+x1)/2;
         return back_nbr_spinor[1] + offset*mySpinorSiteSize;
@@ -348,7 +356,7 @@ static inline Float *spinorNeighbor_mg4dir(int i, int dir, int oddBit, Float *sp
     }
   case 4://+Z
     {
-      int new_x3 = (x3 + nb)% X3;
+      int new_x3 = LatticeGeometry::wrap(x3 + nb, X3);
       if(x3+nb >=X3 && comm_dim_partitioned(2)){
         int offset = ( x3 + nb -X3)*X4*X2*X1/2+(x4*X2*X1 + x2*X1+x1)/2;
         return fwd_nbr_spinor[2] + offset*mySpinorSiteSize;
@@ -358,7 +366,7 @@ static inline Float *spinorNeighbor_mg4dir(int i, int dir, int oddBit, Float *sp
     }
   case 5://-Z
     {
-      int new_x3 = (x3 - nb + X3)% X3;
+      int new_x3 = LatticeGeometry::wrap(x3 - nb, X3);
       if(x3 - nb < 0 && comm_dim_partitioned(2)){
         int offset = ( x3 + nFace -nb)*X4*X2*X1/2+(x4*X2*X1 + x2*X1+x1)/2;
         return back_nbr_spinor[2] + offset*mySpinorSiteSize;
@@ -397,20 +405,16 @@ int neighborIndex_5d_mgpu(int i, int oddBit, int dxs, int dx4, int dx3, int dx2,
 {
   int ret;
 
-  int Y = (type == QUDA_5D_PC) ? fullLatticeIndex_5d(i, oddBit) : fullLatticeIndex_5d_4dpc(i, oddBit);
-
-  int xs = Y/(Z[3]*Z[2]*Z[1]*Z[0]);
-  int x4 = (Y/(Z[2]*Z[1]*Z[0])) % Z[3];
-  int x3 = (Y/(Z[1]*Z[0])) % Z[2];
-  int x2 = (Y/Z[0]) % Z[1];
-  int x1 = Y % Z[0];
+  int x[5];
+  latticeGeometry(Z, Ls).coords5d(x, i, oddBit, type);
+  int xs = x[4], x4 = x[3], x3 = x[2], x2 = x[1], x1 = x[0];
   int ghost_x4 = x4+ dx4;
 
-  xs = (xs+dxs+Ls) % Ls;
-  x4 = (x4+dx4+Z[3]) % Z[3];
-  x3 = (x3+dx3+Z[2]) % Z[2];
-  x2 = (x2+dx2+Z[1]) % Z[1];
-  x1 = (x1+dx1+Z[0]) % Z[0];
+  xs = LatticeGeometry::wrap(xs+dxs, Ls);
+  x4 = LatticeGeometry::wrap(x4+dx4, Z[3]);
+  x3 = LatticeGeometry::wrap(x3+dx3, Z[2]);
+  x2 = LatticeGeometry::wrap(x2+dx2, Z[1]);
+  x1 = LatticeGeometry::wrap(x1+dx1, Z[0]);
 
   if ( (ghost_x4 >= 0 && ghost_x4) < Z[3] || !comm_dim_partitioned(3)){
     ret = (xs*Z[3]*Z[2]*Z[1]*Z[0] + x4*Z[2]*Z[1]*Z[0] + x3*Z[1]*Z[0] + x2*Z[0] + x1) >> 1;
@@ -424,8 +428,9 @@ int neighborIndex_5d_mgpu(int i, int oddBit, int dxs, int dx4, int dx3, int dx2,
 template <QudaDWFPCType type>
 int x4_5d_mgpu(int i, int oddBit)
 {
-  int Y = (type == QUDA_5D_PC) ? fullLatticeIndex_5d(i, oddBit) : fullLatticeIndex_5d_4dpc(i, oddBit);
-  return (Y/(Z[2]*Z[1]*Z[0])) % Z[3];
+  int x[5];
+  latticeGeometry(Z, Ls).coords5d(x, i, oddBit, type);
+  return x[3];
 }
 
 
@@ -434,13 +439,9 @@ Float *spinorNeighbor_5d_mgpu(int i, int dir, int oddBit, Float *spinorField, Fl
 {
   int j;
   int nb = neighbor_distance;
-  int Y = (type == QUDA_5D_PC) ? fullLatticeIndex_5d(i, oddBit) : fullLatticeIndex_5d_4dpc(i, oddBit);
-
-  int xs = Y/(Z[3]*Z[2]*Z[1]*Z[0]);
-  int x4 = (Y/(Z[2]*Z[1]*Z[0])) % Z[3];
-  int x3 = (Y/(Z[1]*Z[0])) % Z[2];
-  int x2 = (Y/Z[0]) % Z[1];
-  int x1 = Y % Z[0];
+  int x[5];
+  latticeGeometry(Z, Ls).coords5d(x, i, oddBit, type);
+  int xs = x[4], x4 = x[3], x3 = x[2], x2 = x[1], x1 = x[0];
 
   int X1= Z[0];
   int X2= Z[1];
@@ -449,7 +450,7 @@ Float *spinorNeighbor_5d_mgpu(int i, int dir, int oddBit, Float *spinorField, Fl
   switch (dir) {
   case 0://+X
     {
-      int new_x1 = (x1 + nb)% X1;
+      int new_x1 = LatticeGeometry::wrap(x1 + nb, X1);
       if(x1+nb >=X1 && comm_dim_partitioned(0)) {
         int offset = ((x1 + nb -X1)*Ls*X4*X3*X2+xs*X4*X3*X2+x4*X3*X2 + x3*X2+x2) >> 1;
         return fwd_nbr_spinor[0] + offset*spinorSize;
@@ -459,7 +460,7 @@ Float *spinorNeighbor_5d_mgpu(int i, int dir, int oddBit, Float *spinorField, Fl
     }
   case 1://-X
     {
-      int new_x1 = (x1 - nb + X1)% X1;
+      int new_x1 = LatticeGeometry::wrap(x1 - nb, X1);
       if(x1 - nb < 0 && comm_dim_partitioned(0)) {
         int offset = (( x1+nFace- nb)*Ls*X4*X3*X2 + xs*X4*X3*X2 + x4*X3*X2 + x3*X2 + x2) >> 1;
         return back_nbr_spinor[0] + offset*spinorSize;
@@ -469,7 +470,7 @@ Float *spinorNeighbor_5d_mgpu(int i, int dir, int oddBit, Float *spinorField, Fl
     }
   case 2://+Y
     {
-      int new_x2 = (x2 + nb)% X2;
+      int new_x2 = LatticeGeometry::wrap(x2 + nb, X2);
       if(x2+nb >=X2 && comm_dim_partitioned(1)) {
         int offset = (( x2 + nb -X2)*Ls*X4*X3*X1+xs*X4*X3*X1+x4*X3*X1 + x3*X1+x1) >> 1;
         return fwd_nbr_spinor[1] + offset*spinorSize;
@@ -479,7 +480,7 @@ Float *spinorNeighbor_5d_mgpu(int i, int dir, int oddBit, Float *spinorField, Fl
     }
   case 3:// -Y
     {
-      int new_x2 = (x2 - nb + X2)% X2;
+      int new_x2 = LatticeGeometry::wrap(x2 - nb, X2);
       if(x2 - nb < 0 && comm_dim_partitioned(1)) {
         int offset = (( x2 + nFace -nb)*Ls*X4*X3*X1+xs*X4*X3*X1+ x4*X3*X1 + x3*X1+x1) >> 1;
         return back_nbr_spinor[1] + offset*spinorSize;
@@ -489,7 +490,7 @@ Float *spinorNeighbor_5d_mgpu(int i, int dir, int oddBit, Float *spinorField, Fl
     }
   case 4://+Z
     {
-      int new_x3 = (x3 + nb)% X3;
+      int new_x3 = LatticeGeometry::wrap(x3 + nb, X3);
       if(x3+nb >=X3 && comm_dim_partitioned(2)) {
         int offset = (( x3 + nb -X3)*Ls*X4*X2*X1+xs*X4*X2*X1+x4*X2*X1 + x2*X1+x1) >> 1;
         return fwd_nbr_spinor[2] + offset*spinorSize;
@@ -499,7 +500,7 @@ Float *spinorNeighbor_5d_mgpu(int i, int dir, int oddBit, Float *spinorField, Fl
     }
   case 5://-Z
     {
-      int new_x3 = (x3 - nb + X3)% X3;
+      int new_x3 = LatticeGeometry::wrap(x3 - nb, X3);
       if(x3 - nb < 0 && comm_dim_partitioned(2)){
         int offset = (( x3 + nFace -nb)*Ls*X4*X2*X1+xs*X4*X2*X1+x4*X2*X1+x2*X1+x1) >> 1;
         return back_nbr_spinor[2] + offset*spinorSize;
@@ -222,20 +222,8 @@ gf_neighborIndexFullLattice(int i, int dx4, int dx3, int dx2, int dx1)
     oddBit =1;
     half_idx = i - Vh;
   }
-  int X1 = Z[0];  
-  int X2 = Z[1];
-  int X3 = Z[2];
-  //int X4 = Z[3];
-  int X1h =X1/2;
-
-  int za = half_idx/X1h;
-  int x1h = half_idx - za*X1h;
-  int zb = za/X2;
-  int x2 = za - zb*X2;
-  int x4 = zb/X3;
-  int x3 = zb - x4*X3;
-  int x1odd = (x2 + x3 + x4 + oddBit) & 1;
-  int x1 = 2*x1h + x1odd;
+  const int *x = latticeGeometry(Z).coords(half_idx, oddBit);
+  int x4 = x[3], x3 = x[2], x2 = x[1], x1 = x[0];
 
 #ifdef MULTI_GPU
   x4 = x4+dx4;
@@ -245,10 +233,10 @@ gf_neighborIndexFullLattice(int i, int dx4, int dx3, int dx2, int dx1)
   
   int nbr_half_idx = ( (x4+2)*(E[2]*E[1]*E[0]) + (x3+2)*(E[1]*E[0]) + (x2+2)*(E[0]) + (x1+2)) / 2;
 #else
-  x4 = (x4+dx4+Z[3]) % Z[3];
-  x3 = (x3+dx3+Z[2]) % Z[2];
-  x2 = (x2+dx2+Z[1]) % Z[1];
-  x1 = (x1+dx1+Z[0]) % Z[0];
+  x4 = LatticeGeometry::wrap(x4+dx4, Z[3]);
+  x3 = LatticeGeometry::wrap(x3+dx3, Z[2]);
+  x2 = LatticeGeometry::wrap(x2+dx2, Z[1]);
+  x1 = LatticeGeometry::wrap(x1+dx1, Z[0]);
  
   int nbr_half_idx = (x4*(Z[2]*Z[1]*Z[0]) + x3*(Z[1]*Z[0]) + x2*(Z[0]) + x1) / 2;
 #endif
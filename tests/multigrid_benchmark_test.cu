@@ -11,6 +11,7 @@
 // include because of nasty globals used in the tests
 #include <dslash_util.h>
 #include <dirac_quda.h>
+#include <multigrid.h>
 
 #define MAX(a,b) ((a)>(b)?(a):(b))
 
@@ -186,6 +187,115 @@ void freeFields()
   delete Yhat_d;
 }
 
+/**
+   Fill a QDP-ordered host link field with uniform random elements
+   in [-0.5,0.5].  Fields filled with the same seed hold the same
+   elements, up to their precision.
+ */
+template <typename Float> void fillRandom(cpuGaugeField &U, unsigned int seed)
+{
+  srand(seed);
+  Float **u = static_cast<Float**>(U.Gauge_p());
+  const size_t n = (size_t)U.Volume() * U.Ncolor() * U.Ncolor() * 2;
+  for (int d=0; d<U.Geometry(); d++)
+    for (size_t i=0; i<n; i++) u[d][i] = static_cast<Float>(rand() / (double)RAND_MAX - 0.5);
+}
+
+void fillRandom(cpuGaugeField &U, unsigned int seed)
+{
+  if (U.Precision() == QUDA_DOUBLE_PRECISION) fillRandom<double>(U, seed);
+  else fillRandom<float>(U, seed);
+}
+
+/**
+   Check the host coarse operator applied to half or quarter precision
+   (block-float) spinors against the same operator applied in double
+   precision (single precision if double-precision multigrid is not
+   enabled).  The reference is computed from the quantized input, so
+   that only the error of the low-precision application is measured.
+   The check uses a local 4^4 lattice without communication, since
+   host block-float spinors cannot be exchanged.
+   @return Relative deviation from the reference
+ */
+double verifyHostBlockFloat(QudaPrecision precision)
+{
+#ifdef GPU_MULTIGRID_DOUBLE
+  const QudaPrecision ref_precision = QUDA_DOUBLE_PRECISION;
+#else
+  const QudaPrecision ref_precision = QUDA_SINGLE_PRECISION;
+#endif
+  const int L = 4;
+
+  ColorSpinorParam param;
+  param.nColor = Ncolor;
+  param.nSpin = Nspin;
+  param.nDim = 4;
+  param.pad = 0;
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  for (int d=0; d<4; d++) param.x[d] = L;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.setPrecision(QUDA_DOUBLE_PRECISION);
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+
+  cpuColorSpinorField in(param), out(param);
+  in.Source(QUDA_RANDOM_SOURCE, 0, 0, 0);
+
+  // half and quarter fields are converted to and from through single precision
+  param.setPrecision(QUDA_SINGLE_PRECISION);
+  cpuColorSpinorField tmp(param);
+  param.setPrecision(precision);
+  cpuColorSpinorField in_lo(param), out_lo(param);
+  param.setPrecision(ref_precision);
+  cpuColorSpinorField in_ref(param), out_ref(param);
+
+  tmp = in; in_lo = tmp; tmp = in_lo; in_ref = tmp;
+
+  GaugeFieldParam gParam;
+  for (int d=0; d<4; d++) gParam.x[d] = L;
+  gParam.nColor = Ncolor*Nspin;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.link_type = QUDA_COARSE_LINKS;
+  gParam.t_boundary = QUDA_PERIODIC_T;
+  gParam.create = QUDA_ZERO_FIELD_CREATE;
+  gParam.nDim = 4;
+  gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  gParam.nFace = 1;
+  gParam.geometry = QUDA_COARSE_GEOMETRY;
+
+  gParam.setPrecision(ref_precision);
+  cpuGaugeField Y_ref(gParam);
+  gParam.setPrecision(QUDA_SINGLE_PRECISION);
+  cpuGaugeField Y_lo(gParam);
+
+  gParam.geometry = QUDA_SCALAR_GEOMETRY;
+  gParam.nFace = 0;
+  gParam.setPrecision(ref_precision);
+  cpuGaugeField X_ref(gParam);
+  gParam.setPrecision(QUDA_SINGLE_PRECISION);
+  cpuGaugeField X_lo(gParam);
+
+  fillRandom(Y_ref, 1234);
+  fillRandom(Y_lo, 1234);
+  fillRandom(X_ref, 5678);
+  fillRandom(X_lo, 5678);
+
+  const int commDim[QUDA_MAX_DIM] = { };
+  const double kappa = 0.1;
+  ApplyCoarse(out_ref, in_ref, in_ref, Y_ref, X_ref, kappa, QUDA_INVALID_PARITY, true, true, false, commDim, QUDA_INVALID_PRECISION);
+  ApplyCoarse(out_lo, in_lo, in_lo, Y_lo, X_lo, kappa, QUDA_INVALID_PARITY, true, true, false, commDim, QUDA_INVALID_PRECISION);
+
+  // compare in double precision, reusing the input fields
+  tmp = out_lo; out = tmp;
+  in = out_ref;
+  double ref2 = blas::norm2(in);
+  blas::axpy(-1.0, in, out);
+  return sqrt(blas::norm2(out) / ref2);
+}
+
 DiracCoarse *dirac;
 
 double benchmark(int test, const int niter) {
@@ -252,11 +362,22 @@ int main(int argc, char** argv)
   Nspin = 2;
 
   printfQuda("\nBenchmarking %s precision with %d iterations...\n\n", get_prec_str(prec), niter);
+  int result = 0;
   for (int c=24; c<=32; c+=8) {
     Ncolor = c;
 
     initFields(prec);
 
+    if (verify_results) {
+      // host half and quarter precision operator
+      for (QudaPrecision p : {QUDA_HALF_PRECISION, QUDA_QUARTER_PRECISION}) {
+        double deviation = verifyHostBlockFloat(p);
+        double tol = (p == QUDA_HALF_PRECISION ? 1e-3 : 1e-1);
+        printfQuda("Ncolor = %2d, host %s precision: deviation = %e (tolerance %e)\n", Ncolor, get_prec_str(p), deviation, tol);
+        if (!(deviation <= tol)) result = 1;
+      }
+    }
+
     DiracParam param;
     param.halo_precision = smoother_halo_prec;
     dirac = new DiracCoarse(param, Y_h, X_h, Xinv_h, Yhat_h, Y_d, X_d, Xinv_d, Yhat_d);
@@ -282,4 +403,5 @@ int main(int argc, char** argv)
   endQuda();
 
   finalizeComms();
+  return result;
 }
@@ -17,15 +17,6 @@ extern void *memset(void *s, int c, size_t n);
 
 #include <dslash_util.h>
 
-//
-// dslashReference()
-//
-// if oddBit is zero: calculate even parity spinor elements (using odd parity spinor) 
-// if oddBit is one:  calculate odd parity spinor elements 
-//
-// if daggerBit is zero: perform ordinary dslash operator
-// if daggerBit is one:  perform hermitian conjugate of dslash
-//
 template<typename Float>
 void display_link_internal(Float* link)
 {
@@ -42,64 +33,89 @@ void display_link_internal(Float* link)
 }
 
 
+//
+// dslashReference()
+//
+// if oddBit is zero: calculate even parity spinor elements (using odd parity spinor) 
+// if oddBit is one:  calculate odd parity spinor elements 
+//
+// if daggerBit is zero: perform ordinary dslash operator
+// if daggerBit is one:  perform hermitian conjugate of dslash
+//
+// Both the single- and multi-GPU references are applied by
+// dslashStaggered, which takes the one- and three-hop neighbours from
+// the precomputed neighborTable.  The sites are independent and are
+// distributed over threads; the sixteen links and neighbour addresses
+// of a site are looked up once and then applied to all nSrc
+// right-hand sides.  Without ghost, all hops wrap around the local
+// lattice and the ghost arguments are unused.
+//
 template <typename sFloat, typename gFloat>
-void dslashReference(sFloat *res, gFloat **fatlink, gFloat** longlink, sFloat *spinorField, 
-		     int oddBit, int daggerBit, bool isLaplace) 
+static void dslashStaggered(sFloat *res, gFloat **fatlink, gFloat **longlink, gFloat **ghostFatlink, gFloat **ghostLonglink,
+                            sFloat *spinorField, sFloat **fwdSpinor, sFloat **backSpinor,
+                            int oddBit, int daggerBit, int nSrc, bool isLaplace, bool ghost)
 {
-  const int nSrc = Ls; // Ls should already be set
-
-  for (int i=0; i<Vh*mySpinorSiteSize*nSrc; i++) res[i] = 0.0;
-  
-  gFloat *fatlinkEven[4], *fatlinkOdd[4];
-  gFloat *longlinkEven[4], *longlinkOdd[4];
-  
-  for (int dir = 0; dir < 4; dir++) {  
-    fatlinkEven[dir] = fatlink[dir];
-    fatlinkOdd[dir] = fatlink[dir] + Vh*gaugeSiteSize;
-    longlinkEven[dir] =longlink[dir];
-    longlinkOdd[dir] = longlink[dir] + Vh*gaugeSiteSize;    
+  const int distance[2] = {1, 3}; // fat and long links
+  gFloat **link[2] = {fatlink, longlink};
+  gFloat **ghostLink[2] = {ghostFatlink, ghostLonglink};
+
+  // the spinor ghost zone is always three deep, the link ghost zones are as deep as the hop
+  const LatticeNeighbor *linkNbr[2], *spinorNbr[2];
+  for (int h = 0; h < 2; h++) {
+    linkNbr[h] = neighborTable(distance[h], distance[h], ghost) + oddBit * 8 * Vh;
+    spinorNbr[h] = neighborTable(distance[h], 3, ghost, nSrc) + oddBit * 8 * Vh;
   }
 
-  for (int xs=0; xs<nSrc; xs++) {
+#pragma omp parallel for
+  for (int i = 0; i < Vh; i++) {
+    gFloat *lnk[8][2];
+    const LatticeNeighbor *nbr[8][2];
+
+    for (int dir = 0; dir < 8; dir++) {
+      const int d = dir/2;
+      for (int h = 0; h < 2; h++) {
+        const LatticeNeighbor &n = linkNbr[h][dir*Vh + i];
+        // forward links live on this site, backward links on the neighbour (of the other parity)
+        if (dir % 2 == 0) lnk[dir][h] = &link[h][d][(oddBit*Vh + i)*gaugeSiteSize];
+        else if (n.region == LatticeNeighbor::BODY) lnk[dir][h] = &link[h][d][((1-oddBit)*Vh + n.index)*gaugeSiteSize];
+        else lnk[dir][h] = &ghostLink[h][d][((1-oddBit)*distance[h]*(faceVolume[d]/2) + n.index)*gaugeSiteSize];
+        nbr[dir][h] = &spinorNbr[h][dir*Vh + i];
+      }
+    }
 
-    for (int i = 0; i < Vh; i++) {
-      int sid = i + xs*Vh;
-      int offset = mySpinorSiteSize*sid;
+    for (int xs = 0; xs < nSrc; xs++) {
+      sFloat out[3*2] = { };
 
       for (int dir = 0; dir < 8; dir++) {
-        gFloat* fatlnk = gaugeLink(i, dir, oddBit, fatlinkEven, fatlinkOdd, 1);
-        gFloat* longlnk = gaugeLink(i, dir, oddBit, longlinkEven, longlinkOdd, 3);
-
-        sFloat *first_neighbor_spinor = spinorNeighbor_5d<QUDA_4D_PC>(sid, dir, oddBit, spinorField, 1, mySpinorSiteSize);
-        sFloat *third_neighbor_spinor = spinorNeighbor_5d<QUDA_4D_PC>(sid, dir, oddBit, spinorField, 3, mySpinorSiteSize);
-
-        sFloat gaugedSpinor[mySpinorSiteSize];
-
-        if (dir % 2 == 0){
-          su3Mul(gaugedSpinor, fatlnk, first_neighbor_spinor);
-          sum(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-          su3Mul(gaugedSpinor, longlnk, third_neighbor_spinor);
-          sum(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-        } else {
-          su3Tmul(gaugedSpinor, fatlnk, first_neighbor_spinor);
-          if (isLaplace) {
-            sum(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-          } else {
-            sub(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-          }
-          su3Tmul(gaugedSpinor, longlnk, third_neighbor_spinor);
-          if (isLaplace) {
-            sum(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
+        for (int h = 0; h < 2; h++) {
+          sFloat *spinor = neighborSite(*nbr[dir][h], spinorField, fwdSpinor, backSpinor, mySpinorSiteSize, xs);
+          sFloat gaugedSpinor[3*2];
+
+          if (dir % 2 == 0) {
+            su3Mul(gaugedSpinor, lnk[dir][h], spinor);
+            sum(out, out, gaugedSpinor, 3*2);
           } else {
-            sub(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
+            su3Tmul(gaugedSpinor, lnk[dir][h], spinor);
+            if (isLaplace) sum(out, out, gaugedSpinor, 3*2);
+            else sub(out, out, gaugedSpinor, 3*2);
           }
         }
       }
 
-      if (daggerBit) negx(&res[offset], mySpinorSiteSize);
-    } // 4-d volume
-  } // right-hand-side
-  
+      if (daggerBit) negx(out, 3*2);
+      sFloat *dst = &res[(xs*Vh + i)*mySpinorSiteSize];
+      for (int j = 0; j < 3*2; j++) dst[j] = out[j];
+    } // right-hand-side
+  } // 4-d volume
+}
+
+template <typename sFloat, typename gFloat>
+void dslashReference(sFloat *res, gFloat **fatlink, gFloat** longlink, sFloat *spinorField, 
+		     int oddBit, int daggerBit, bool isLaplace) 
+{
+  const int nSrc = Ls; // Ls should already be set
+  dslashStaggered(res, fatlink, longlink, (gFloat**)nullptr, (gFloat**)nullptr, spinorField,
+                  (sFloat**)nullptr, (sFloat**)nullptr, oddBit, daggerBit, nSrc, isLaplace, false);
 }
 
 
@@ -282,65 +298,8 @@ void dslashReference_mg4dir(sFloat *res, gFloat **fatlink, gFloat** longlink,
 			    sFloat *spinorField, sFloat** fwd_nbr_spinor, 
 			    sFloat** back_nbr_spinor, int oddBit, int daggerBit, int nSrc, bool isLaplace)
 {
-  for (int i=0; i<Vh*mySpinorSiteSize*nSrc; i++) res[i] = 0.0;
-
-  gFloat *fatlinkEven[4], *fatlinkOdd[4];
-  gFloat *longlinkEven[4], *longlinkOdd[4];
-  gFloat *ghostFatlinkEven[4], *ghostFatlinkOdd[4];
-  gFloat *ghostLonglinkEven[4], *ghostLonglinkOdd[4];
-
-  for (int dir = 0; dir < 4; dir++) {
-    fatlinkEven[dir] = fatlink[dir];
-    fatlinkOdd[dir] = fatlink[dir] + Vh*gaugeSiteSize;
-    longlinkEven[dir] =longlink[dir];
-    longlinkOdd[dir] = longlink[dir] + Vh*gaugeSiteSize;
-    
-    ghostFatlinkEven[dir] = ghostFatlink[dir];
-    ghostFatlinkOdd[dir] = ghostFatlink[dir] + (faceVolume[dir]/2)*gaugeSiteSize;
-    ghostLonglinkEven[dir] = ghostLonglink[dir];
-    ghostLonglinkOdd[dir] = ghostLonglink[dir] + 3*(faceVolume[dir]/2)*gaugeSiteSize;
-  }
-
-  for (int xs=0; xs<nSrc; xs++) {
-
-    for (int i = 0; i < Vh; i++) {
-      int sid = i + xs*Vh;
-      int offset = mySpinorSiteSize*sid;
-
-      for (int dir = 0; dir < 8; dir++) {
-        gFloat* fatlnk = gaugeLink_mg4dir(i, dir, oddBit, fatlinkEven, fatlinkOdd, ghostFatlinkEven, ghostFatlinkOdd, 1, 1);
-        gFloat* longlnk = gaugeLink_mg4dir(i, dir, oddBit, longlinkEven, longlinkOdd, ghostLonglinkEven, ghostLonglinkOdd, 3, 3);
-
-        sFloat *first_neighbor_spinor = spinorNeighbor_5d_mgpu<QUDA_4D_PC>(sid, dir, oddBit, spinorField, fwd_nbr_spinor, back_nbr_spinor, 1, 3, mySpinorSiteSize);
-        sFloat *third_neighbor_spinor = spinorNeighbor_5d_mgpu<QUDA_4D_PC>(sid, dir, oddBit, spinorField, fwd_nbr_spinor, back_nbr_spinor, 3, 3, mySpinorSiteSize);
-
-        sFloat gaugedSpinor[mySpinorSiteSize];
-
-        if (dir % 2 == 0){
-          su3Mul(gaugedSpinor, fatlnk, first_neighbor_spinor);
-          sum(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-          su3Mul(gaugedSpinor, longlnk, third_neighbor_spinor);
-          sum(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-        } else {
-          su3Tmul(gaugedSpinor, fatlnk, first_neighbor_spinor);
-          if (isLaplace) {
-            sum(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-          } else {
-            sub(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-          }
-          su3Tmul(gaugedSpinor, longlnk, third_neighbor_spinor);
-          if (isLaplace) {
-            sum(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-          } else {
-            sub(&res[offset], &res[offset], gaugedSpinor, mySpinorSiteSize);
-          }
-        }
-      }
-
-      if (daggerBit) negx(&res[offset], mySpinorSiteSize);
-    } // 4-d volume
-  } // right-hand-side
-
+  dslashStaggered(res, fatlink, longlink, ghostFatlink, ghostLonglink, spinorField,
+                  fwd_nbr_spinor, back_nbr_spinor, oddBit, daggerBit, nSrc, isLaplace, true);
 }
 
 
@@ -3,6 +3,7 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
+#include <vector>
 
 #include <util_quda.h>
 #include <test_util.h>
@@ -20,6 +21,11 @@
 // In a typical application, quda.h is the only QUDA header required.
 #include <quda.h>
 
+// internal headers, used for checking the host gauge tools against the device
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <comm_quda.h>
+
 extern bool tune;
 extern int device;
 extern int xdim;
@@ -84,7 +90,113 @@ void setGaugeParam(QudaGaugeParam &gauge_param) {
 
 extern void usage(char**);
 
-void SU3test(int argc, char **argv) {
+#ifdef GPU_GAUGE_TOOLS
+/**
+   Create an extended host copy of a QDP-ordered host gauge field,
+   with the halo filled in the partitioned dimensions
+ */
+quda::cpuGaugeField *createExtendedHostGauge(void **gauge, QudaGaugeParam &gauge_param)
+{
+  quda::GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  quda::cpuGaugeField in(gParam);
+
+  int R[4];
+  for (int d=0; d<4; d++) R[d] = 2 * comm_dim_partitioned(d);
+  for (int d=0; d<4; d++) {
+    gParam.x[d] += 2 * R[d];
+    gParam.r[d] = R[d];
+  }
+  gParam.create = QUDA_ZERO_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  gParam.gauge = nullptr;
+
+  quda::cpuGaugeField *out = new quda::cpuGaugeField(gParam);
+  quda::copyExtendedGauge(*out, in, QUDA_CPU_FIELD_LOCATION);
+  out->exchangeExtendedGhost(R);
+  return out;
+}
+
+/**
+   Compare the host plaquette and topological charge of the gauge
+   field with the device values, and check that the charges of the
+   timeslices sum to the total.  Returns 1 if they all agree.
+ */
+int checkHostObservables(void **gauge, QudaGaugeParam &gauge_param, const double *plaq, double qCharge)
+{
+  quda::cpuGaugeField *U = createExtendedHostGauge(gauge, gauge_param);
+  double3 plq = quda::plaquette(*U, QUDA_CPU_FIELD_LOCATION);
+
+  // host Fmunu fields are only supported in MILC order
+  quda::GaugeFieldParam tensorParam(gauge_param.X, gauge_param.cpu_prec, QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
+  tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  tensorParam.order = QUDA_MILC_GAUGE_ORDER;
+  tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  quda::cpuGaugeField Fmunu(tensorParam);
+  quda::computeFmunu(Fmunu, *U, QUDA_CPU_FIELD_LOCATION);
+  delete U;
+
+  double q_host = quda::computeQCharge(Fmunu, QUDA_CPU_FIELD_LOCATION);
+  std::vector<double> q_t(comm_dim(3) * gauge_param.X[3]);
+  double q_total = quda::computeQChargeTimeslice(q_t.data(), Fmunu);
+  double q_sum = 0.0;
+  for (auto q : q_t) q_sum += q;
+
+  double tol = gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+  double q_scale = MAX(1.0, fabs(qCharge));
+
+  double plaq_deviation = MAX(fabs(plq.x - plaq[0]), MAX(fabs(plq.y - plaq[1]), fabs(plq.z - plaq[2])));
+  int plaq_res = plaq_deviation <= tol ? 1 : 0;
+  printfQuda("Host plaquette %e (device %e, deviation %e): %s\n", plq.x, plaq[0], plaq_deviation,
+             (1 == plaq_res) ? "PASSED" : "FAILED");
+
+  double q_deviation = MAX(fabs(q_host - qCharge), fabs(q_total - qCharge)) / q_scale;
+  int q_res = q_deviation <= tol ? 1 : 0;
+  printfQuda("Host topological charge %e (device %e, relative deviation %e): %s\n", q_host, qCharge, q_deviation,
+             (1 == q_res) ? "PASSED" : "FAILED");
+
+  double q_t_deviation = fabs(q_sum - q_total) / q_scale;
+  int q_t_res = q_t_deviation <= tol ? 1 : 0;
+  printfQuda("Sum of timeslice charges %e (total %e, relative deviation %e): %s\n", q_sum, q_total, q_t_deviation,
+             (1 == q_t_res) ? "PASSED" : "FAILED");
+
+  return plaq_res & q_res & q_t_res;
+}
+
+/**
+   Smear a host copy of the unsmeared gauge field and compare its
+   plaquette with that of the device smeared field, which is
+   downloaded to smeared.  Returns 1 if they agree.
+ */
+template <typename Smear>
+int checkHostSmearing(const char *name, void **gauge, void **smeared, QudaGaugeParam &gauge_param, Smear smear)
+{
+  quda::cpuGaugeField *U = createExtendedHostGauge(gauge, gauge_param);
+  quda::GaugeFieldParam tmpParam(*U);
+  tmpParam.create = QUDA_NULL_FIELD_CREATE;
+  quda::cpuGaugeField tmp(tmpParam);
+  smear(*U, tmp);
+  double3 plq_host = quda::plaquette(*U, QUDA_CPU_FIELD_LOCATION);
+  delete U;
+
+  // both fields are measured with the host plaquette, so only the smearing is compared
+  QudaGaugeParam smeared_param = gauge_param;
+  smeared_param.type = QUDA_SMEARED_LINKS;
+  saveGaugeQuda(smeared, &smeared_param);
+  quda::cpuGaugeField *V = createExtendedHostGauge(smeared, smeared_param);
+  double3 plq_device = quda::plaquette(*V, QUDA_CPU_FIELD_LOCATION);
+  delete V;
+
+  double tol = gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+  double deviation = MAX(fabs(plq_host.x - plq_device.x), MAX(fabs(plq_host.y - plq_device.y), fabs(plq_host.z - plq_device.z)));
+  int res = deviation <= tol ? 1 : 0;
+  printfQuda("Host %s plaquette %e (device %e, deviation %e): %s\n", name, plq_host.x, plq_device.x, deviation,
+             (1 == res) ? "PASSED" : "FAILED");
+  return res;
+}
+#endif
+
+int SU3test(int argc, char **argv) {
 
   for (int i = 1; i < argc; i++){
     if(process_command_line_option(argc, argv, &i) == 0){
@@ -136,6 +248,8 @@ void SU3test(int argc, char **argv) {
   loadGaugeQuda(gauge, &gauge_param);
   saveGaugeQuda(new_gauge, &gauge_param);
 
+  int res = 1;
+
   double plaq[3];
   plaqQuda(plaq);
   printfQuda("Computed plaquette is %e (spatial = %e, temporal = %e)\n", plaq[0], plaq[1], plaq[2]);
@@ -150,6 +264,7 @@ void SU3test(int argc, char **argv) {
   time0 += clock();
   time0 /= CLOCKS_PER_SEC;
   printfQuda("Computed topological charge is %.16e Done in %g secs\n", qCharge, time0);
+  if (verify_results) res &= checkHostObservables(gauge, gauge_param, plaq, qCharge);
 
   // Stout smearing should be equivalent to APE smearing
   // on D dimensional lattices for rho = alpha/2*(D-1). 
@@ -168,6 +283,10 @@ void SU3test(int argc, char **argv) {
   printfQuda("Total time for STOUT = %g secs\n", time0);
   qCharge = qChargeCuda();
   printfQuda("Computed topological charge after is %.16e \n", qCharge);
+  if (verify_results)
+    res &= checkHostSmearing("STOUT", gauge, new_gauge, gauge_param, [&](quda::GaugeField &U, quda::GaugeField &tmp) {
+      quda::STOUTnStep(U, tmp, nSteps, coeff_STOUT);
+    });
 
   //APE
   // start the timer
@@ -179,6 +298,10 @@ void SU3test(int argc, char **argv) {
   printfQuda("Total time for APE = %g secs\n", time0);
   qCharge = qChargeCuda();
   printf("Computed topological charge after is %.16e \n", qCharge);
+  if (verify_results)
+    res &= checkHostSmearing("APE", gauge, new_gauge, gauge_param, [&](quda::GaugeField &U, quda::GaugeField &tmp) {
+      quda::APEnStep(U, tmp, nSteps, coeff_APE);
+    });
 
   //Over Improved STOUT
   double epsilon = -0.25;
@@ -193,11 +316,18 @@ void SU3test(int argc, char **argv) {
   printfQuda("Total time for Over Improved STOUT = %g secs\n", time0);
   qCharge = qChargeCuda();
   printfQuda("Computed topological charge after is %.16e \n", qCharge);
+  if (verify_results)
+    res &= checkHostSmearing("Over Improved STOUT", gauge, new_gauge, gauge_param,
+                             [&](quda::GaugeField &U, quda::GaugeField &tmp) {
+                               quda::OvrImpSTOUTnStep(U, tmp, nSteps, coeff_STOUT, epsilon);
+                             });
 
 #else
   printfQuda("Skipping other gauge tests since gauge tools have not been compiled\n");
 #endif
 
+  // the smearing checks reuse new_gauge, so download the unsmeared field again
+  saveGaugeQuda(new_gauge, &gauge_param);
   if (verify_results) check_gauge(gauge, new_gauge, 1e-3, gauge_param.cpu_prec);
 
   freeGaugeQuda();
@@ -210,11 +340,13 @@ void SU3test(int argc, char **argv) {
   }
 
   finalizeComms();
+
+  return res;
 }
 
 int main(int argc, char **argv) {
 
-  SU3test(argc, argv);
+  int res = SU3test(argc, argv);
 
-  return 0;
+  return (1 == res) ? 0 : 1;
 }
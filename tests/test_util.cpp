@@ -1,4 +1,6 @@
 #include <complex>
+#include <map>
+#include <vector>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -226,11 +228,7 @@ void printGaugeElement(void *gauge, int X, QudaPrecision precision) {
 
 // returns 0 or 1 if the full lattice index X is even or odd
 int getOddBit(int Y) {
-  int x4 = Y/(Z[2]*Z[1]*Z[0]);
-  int x3 = (Y/(Z[1]*Z[0])) % Z[2];
-  int x2 = (Y/Z[0]) % Z[1];
-  int x1 = Y % Z[0];
-  return (x4+x3+x2+x1) % 2;
+  return latticeGeometry(Z).fullIndex(Y >> 1, 0) == Y ? 0 : 1;
 }
 
 // a+=b
@@ -439,43 +437,79 @@ int compare_floats(void *a, void *b, int len, double epsilon, QudaPrecision prec
   else return compareFloats((float*)a, (float*)b, len, epsilon);
 }
 
-int fullLatticeIndex(int dim[4], int index, int oddBit){
+LatticeGeometry::LatticeGeometry(const int dim[4], int Ls) : Ls(Ls)
+{
+  for (int d = 0; d < 4; d++) X[d] = dim[d];
+  const int volume = X[0] * X[1] * X[2] * X[3];
+  volumeCB = volume / 2;
+
+  x4d.resize(2 * volumeCB * 4);
+  idx4d.resize(2 * volumeCB);
+
+  for (int parity = 0; parity < 2; parity++) {
+    for (int i = 0; i < volumeCB; i++) {
+      int za = i / (X[0] >> 1);
+      int zb = za / X[1];
+      int x2 = za - zb * X[1];
+      int x4 = zb / X[2];
+      int x3 = zb - x4 * X[2];
+      int Y = 2 * i + ((x2 + x3 + x4 + parity) & 1);
+
+      int *x = &x4d[(parity * volumeCB + i) * 4];
+      x[0] = Y % X[0];
+      x[1] = x2;
+      x[2] = x3;
+      x[3] = x4;
+      idx4d[parity * volumeCB + i] = Y;
+    }
+  }
+
+  // Offsetting a 5-d checkerboard index by one s-slice adds X[1]*X[2]*X[3] + X[2]*X[3] + X[3] boundary
+  // crossings (plus one in the 5-d preconditioned ordering) to the parity of the site.
+  const int crossings = X[1] * X[2] * X[3] + X[2] * X[3] + X[3];
+  const int s_parity[2] = {(crossings + 1) & 1, crossings & 1}; // for QUDA_5D_PC and QUDA_4D_PC
+
+  site5d.resize(2 * 2 * Ls * volumeCB);
+  s5d.resize(Ls * volumeCB);
+
+  for (int s = 0; s < Ls; s++) {
+    for (int i = 0; i < volumeCB; i++) s5d[s * volumeCB + i] = s;
+    for (int type = 0; type < 2; type++) {
+      for (int parity = 0; parity < 2; parity++) {
+        const int parity4d = (parity + s * s_parity[type]) & 1;
+        int *entry = &site5d[((type * 2 + parity) * Ls + s) * volumeCB];
+        for (int i = 0; i < volumeCB; i++) entry[i] = parity4d * volumeCB + i;
+      }
+    }
+  }
+}
 
-  int za = index/(dim[0]>>1);
-  int zb = za/dim[1];
-  int x2 = za - zb*dim[1];
-  int x4 = zb/dim[2];
-  int x3 = zb - x4*dim[2];
-  
-  return  2*index + ((x2 + x3 + x4 + oddBit) & 1);
+const LatticeGeometry &latticeGeometry(const int dim[4], int Ls)
+{
+  // most calls ask for the same lattice as the previous one made by this thread
+  static thread_local const LatticeGeometry *last = nullptr;
+  if (last && last->matches(dim, Ls)) return *last;
+
+#pragma omp critical (latticeGeometry)
+  {
+    static std::map<std::vector<int>, LatticeGeometry> geometries;
+    std::vector<int> key = {dim[0], dim[1], dim[2], dim[3], Ls};
+    auto entry = geometries.find(key);
+    if (entry == geometries.end()) entry = geometries.insert(std::make_pair(key, LatticeGeometry(dim, Ls))).first;
+    last = &entry->second;
+  }
+
+  return *last;
+}
+
+int fullLatticeIndex(int dim[4], int index, int oddBit){
+  return latticeGeometry(dim).fullIndex(index, oddBit);
 }
 
 // given a "half index" i into either an even or odd half lattice (corresponding
 // to oddBit = {0, 1}), returns the corresponding full lattice index.
 int fullLatticeIndex(int i, int oddBit) {
-  /*
-    int boundaryCrossings = i/(Z[0]/2) + i/(Z[1]*Z[0]/2) + i/(Z[2]*Z[1]*Z[0]/2);
-    return 2*i + (boundaryCrossings + oddBit) % 2;
-  */
-
-  int X1 = Z[0];  
-  int X2 = Z[1];
-  int X3 = Z[2];
-  //int X4 = Z[3];
-  int X1h =X1/2;
-
-  int sid =i;
-  int za = sid/X1h;
-  //int x1h = sid - za*X1h;
-  int zb = za/X2;
-  int x2 = za - zb*X2;
-  int x4 = zb/X3;
-  int x3 = zb - x4*X3;
-  int x1odd = (x2 + x3 + x4 + oddBit) & 1;
-  //int x1 = 2*x1h + x1odd;
-  int X = 2*sid + x1odd; 
-
-  return X;
+  return latticeGeometry(Z).fullIndex(i, oddBit);
 }
 
 
@@ -490,70 +524,79 @@ int fullLatticeIndex(int i, int oddBit) {
 //
 
 int neighborIndex(int i, int oddBit, int dx4, int dx3, int dx2, int dx1) {
-  int Y = fullLatticeIndex(i, oddBit);
-  int x4 = Y/(Z[2]*Z[1]*Z[0]);
-  int x3 = (Y/(Z[1]*Z[0])) % Z[2];
-  int x2 = (Y/Z[0]) % Z[1];
-  int x1 = Y % Z[0];
-  
-  // assert (oddBit == (x+y+z+t)%2);
-  
-  x4 = (x4+dx4+Z[3]) % Z[3];
-  x3 = (x3+dx3+Z[2]) % Z[2];
-  x2 = (x2+dx2+Z[1]) % Z[1];
-  x1 = (x1+dx1+Z[0]) % Z[0];
-  
-  return (x4*(Z[2]*Z[1]*Z[0]) + x3*(Z[1]*Z[0]) + x2*(Z[0]) + x1) / 2;
+  const int dx[4] = {dx1, dx2, dx3, dx4};
+  return latticeGeometry(Z).neighbor(i, oddBit, dx);
 }
 
 
 int neighborIndex(int dim[4], int index, int oddBit, int dx[4]){
-
-  const int fullIndex = fullLatticeIndex(dim, index, oddBit);
-
-  int x[4];
-  x[3] = fullIndex/(dim[2]*dim[1]*dim[0]);
-  x[2] = (fullIndex/(dim[1]*dim[0])) % dim[2];
-  x[1] = (fullIndex/dim[0]) % dim[1];
-  x[0] = fullIndex % dim[0];
-
-  for(int dir=0; dir<4; ++dir)
-    x[dir] = (x[dir]+dx[dir]+dim[dir]) % dim[dir];
-
-  return (((x[3]*dim[2] + x[2])*dim[1] + x[1])*dim[0] + x[0])/2;
+  return latticeGeometry(dim).neighbor(index, oddBit, dx);
 }
 
 int
 neighborIndex_mg(int i, int oddBit, int dx4, int dx3, int dx2, int dx1)
 {
-  int ret;
+  const LatticeGeometry &geom = latticeGeometry(Z);
+  const int *x = geom.coords(i, oddBit);
   
-  int Y = fullLatticeIndex(i, oddBit);
-  int x4 = Y/(Z[2]*Z[1]*Z[0]);
-  int x3 = (Y/(Z[1]*Z[0])) % Z[2];
-  int x2 = (Y/Z[0]) % Z[1];
-  int x1 = Y % Z[0];
+  int ghost_x4 = x[3] + dx4;
   
-  int ghost_x4 = x4+ dx4;
+  int y[4] = {LatticeGeometry::wrap(x[0] + dx1, Z[0]), LatticeGeometry::wrap(x[1] + dx2, Z[1]),
+              LatticeGeometry::wrap(x[2] + dx3, Z[2]), LatticeGeometry::wrap(ghost_x4, Z[3])};
   
-  // assert (oddBit == (x+y+z+t)%2);
-  
-  x4 = (x4+dx4+Z[3]) % Z[3];
-  x3 = (x3+dx3+Z[2]) % Z[2];
-  x2 = (x2+dx2+Z[1]) % Z[1];
-  x1 = (x1+dx1+Z[0]) % Z[0];
-  
-  if ( (ghost_x4 >= 0 && ghost_x4 < Z[3]) || !comm_dim_partitioned(3)){
-    ret = (x4*(Z[2]*Z[1]*Z[0]) + x3*(Z[1]*Z[0]) + x2*(Z[0]) + x1) / 2;
-  }else{
-    ret = (x3*(Z[1]*Z[0]) + x2*(Z[0]) + x1) / 2;    
-  }
+  // a hop off a partitioned T boundary returns the index within the face
+  if ( !(ghost_x4 >= 0 && ghost_x4 < Z[3]) && comm_dim_partitioned(3)) y[3] = 0;
 
-  
-  return ret;
+  return geom.index(y);
 }
 
 
+const LatticeNeighbor *neighborTable(int distance, int nFace, bool ghost, int Ls)
+{
+  static std::map<std::vector<int>, std::vector<LatticeNeighbor>> tables;
+
+  int partitioned[4];
+  for (int d = 0; d < 4; d++) partitioned[d] = ghost && comm_dim_partitioned(d);
+
+  std::vector<int> key = {Z[0], Z[1], Z[2], Z[3], distance, nFace, Ls, partitioned[0], partitioned[1], partitioned[2], partitioned[3]};
+  auto entry = tables.find(key);
+  if (entry != tables.end()) return entry->second.data();
+
+  std::vector<LatticeNeighbor> &table = tables[key];
+  table.resize(2 * 8 * Vh);
+  const LatticeGeometry &geom = latticeGeometry(Z);
+
+#pragma omp parallel for
+  for (int i = 0; i < 2 * Vh; i++) {
+    const int parity = i < Vh ? 0 : 1;
+    const int cb = i - parity * Vh;
+    const int *x = geom.coords(cb, parity);
+
+    for (int dir = 0; dir < 8; dir++) {
+      const int d = dir / 2;
+      int y[4] = {x[0], x[1], x[2], x[3]};
+      y[d] += (dir % 2 == 0) ? distance : -distance;
+
+      LatticeNeighbor &n = table[(parity * 8 + dir) * Vh + cb];
+      if (partitioned[d] && (y[d] < 0 || y[d] >= Z[d])) {
+        // lexicographic index of the site within the face, as used by the ghost zone
+        int face_idx = 0;
+        for (int k = 3; k >= 0; k--) if (k != d) face_idx = face_idx * Z[k] + x[k];
+        const bool forward = y[d] >= Z[d];
+        const int layer = forward ? y[d] - Z[d] : y[d] + nFace;
+        n.region = (forward ? LatticeNeighbor::FORWARD_GHOST : LatticeNeighbor::BACKWARD_GHOST) + d;
+        n.index = layer * Ls * (faceVolume[d] / 2) + face_idx / 2;
+      } else {
+        y[d] = LatticeGeometry::wrap(y[d], Z[d]);
+        n.region = LatticeNeighbor::BODY;
+        n.index = geom.index(y);
+      }
+    }
+  }
+
+  return table.data();
+}
+
 /*  
  * This is a computation of neighbor using the full index and the displacement in each direction
  *
@@ -585,8 +628,8 @@ neighborIndexFullLattice(int i, int dx4, int dx3, int dx2, int dx1)
 int
 neighborIndexFullLattice(int dim[4], int index, int dx[4])
 {
-  const int volume = dim[0]*dim[1]*dim[2]*dim[3];
-  const int halfVolume = volume/2;
+  const LatticeGeometry &geom = latticeGeometry(dim);
+  const int halfVolume = geom.VolumeCB();
   int oddBit = 0;
   int halfIndex = index;
 
@@ -595,7 +638,7 @@ neighborIndexFullLattice(int dim[4], int index, int dx[4])
     halfIndex = index - halfVolume;
   }
 
-  int neighborHalfIndex = neighborIndex(dim, halfIndex, oddBit, dx);
+  int neighborHalfIndex = geom.neighbor(halfIndex, oddBit, dx);
 
   int oddBitChanged = (dx[0]+dx[1]+dx[2]+dx[3])%2;
   if(oddBitChanged){
@@ -610,7 +653,6 @@ neighborIndexFullLattice(int dim[4], int index, int dx[4])
 int
 neighborIndexFullLattice_mg(int i, int dx4, int dx3, int dx2, int dx1) 
 {
-  int ret;
   int oddBit = 0;
   int half_idx = i;
   if (i >= Vh){
@@ -618,25 +660,20 @@ neighborIndexFullLattice_mg(int i, int dx4, int dx3, int dx2, int dx1)
     half_idx = i - Vh;
   }
     
-  int Y = fullLatticeIndex(half_idx, oddBit);
-  int x4 = Y/(Z[2]*Z[1]*Z[0]);
-  int x3 = (Y/(Z[1]*Z[0])) % Z[2];
-  int x2 = (Y/Z[0]) % Z[1];
-  int x1 = Y % Z[0];
-  int ghost_x4 = x4+ dx4;
-    
-  x4 = (x4+dx4+Z[3]) % Z[3];
-  x3 = (x3+dx3+Z[2]) % Z[2];
-  x2 = (x2+dx2+Z[1]) % Z[1];
-  x1 = (x1+dx1+Z[0]) % Z[0];
+  const LatticeGeometry &geom = latticeGeometry(Z);
+  const int *x = geom.coords(half_idx, oddBit);
+  int ghost_x4 = x[3] + dx4;
 
-  if ( ghost_x4 >= 0 && ghost_x4 < Z[3]){
-    ret = (x4*(Z[2]*Z[1]*Z[0]) + x3*(Z[1]*Z[0]) + x2*(Z[0]) + x1) / 2;
-  }else{
-    ret = (x3*(Z[1]*Z[0]) + x2*(Z[0]) + x1) / 2;    
-    return ret;
+  int y[4] = {LatticeGeometry::wrap(x[0] + dx1, Z[0]), LatticeGeometry::wrap(x[1] + dx2, Z[1]),
+              LatticeGeometry::wrap(x[2] + dx3, Z[2]), LatticeGeometry::wrap(ghost_x4, Z[3])};
+
+  if ( !(ghost_x4 >= 0 && ghost_x4 < Z[3])){
+    y[3] = 0;
+    return geom.index(y);
   }
 
+  int ret = geom.index(y);
+
   int oddBitChanged = (dx4+dx3+dx2+dx1)%2;
   if (oddBitChanged){
     oddBit = 1 - oddBit;
@@ -657,29 +694,7 @@ neighborIndexFullLattice_mg(int i, int dx4, int dx3, int dx2, int dx1)
 // There, i is the thread index.
 int fullLatticeIndex_4d(int i, int oddBit) {
   if (i >= Vh || i < 0) {printf("i out of range in fullLatticeIndex_4d"); exit(-1);}
-  /*
-    int boundaryCrossings = i/(Z[0]/2) + i/(Z[1]*Z[0]/2) + i/(Z[2]*Z[1]*Z[0]/2);
-    return 2*i + (boundaryCrossings + oddBit) % 2;
-  */
-
-  int X1 = Z[0];  
-  int X2 = Z[1];
-  int X3 = Z[2];
-  //int X4 = Z[3];
-  int X1h =X1/2;
-
-  int sid =i;
-  int za = sid/X1h;
-  //int x1h = sid - za*X1h;
-  int zb = za/X2;
-  int x2 = za - zb*X2;
-  int x4 = zb/X3;
-  int x3 = zb - x4*X3;
-  int x1odd = (x2 + x3 + x4 + oddBit) & 1;
-  //int x1 = 2*x1h + x1odd;
-  int X = 2*sid + x1odd; 
-
-  return X;
+  return latticeGeometry(Z).fullIndex(i, oddBit);
 }
 
 // 5d checkerboard.
@@ -690,13 +705,11 @@ int fullLatticeIndex_4d(int i, int oddBit) {
 // This function is used by neighborIndex_5d in dslash_reference.cpp.
 //ok
 int fullLatticeIndex_5d(int i, int oddBit) {
-  int boundaryCrossings = i/(Z[0]/2) + i/(Z[1]*Z[0]/2) + i/(Z[2]*Z[1]*Z[0]/2) + i/(Z[3]*Z[2]*Z[1]*Z[0]/2);
-  return 2*i + (boundaryCrossings + oddBit) % 2;
+  return latticeGeometry(Z, Ls).fullIndex5d(i, oddBit, QUDA_5D_PC);
 }
 
 int fullLatticeIndex_5d_4dpc(int i, int oddBit) {
-  int boundaryCrossings = i/(Z[0]/2) + i/(Z[1]*Z[0]/2) + i/(Z[2]*Z[1]*Z[0]/2);
-  return 2*i + (boundaryCrossings + oddBit) % 2;
+  return latticeGeometry(Z, Ls).fullIndex5d(i, oddBit, QUDA_4D_PC);
 }
 
 int 
@@ -709,10 +722,7 @@ x4_from_full_index(int i)
     half_idx = i - Vh;
   }
   
-  int Y = fullLatticeIndex(half_idx, oddBit);
-  int x4 = Y/(Z[2]*Z[1]*Z[0]);
-  
-  return x4;
+  return latticeGeometry(Z).coords(half_idx, oddBit)[3];
 }
 
 template <typename Float>
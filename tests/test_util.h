@@ -2,6 +2,7 @@
 #define _TEST_UTIL_H
 
 #include <quda.h>
+#include <vector>
 
 #define gaugeSiteSize 18 // real numbers per link
 #define spinorSiteSize 24 // real numbers per spinor
@@ -47,6 +48,117 @@
   int neighborIndex_mg(int i, int oddBit, int dx4, int dx3, int dx2, int dx1);
   int neighborIndexFullLattice_mg(int i, int dx4, int dx3, int dx2, int dx1);
 
+  /**
+     @brief Location of a neighbouring site of a checkerboarded field:
+     either in the local field or in the ghost zone of a partitioned
+     dimension.
+   */
+  struct LatticeNeighbor {
+    enum { BODY = 0, FORWARD_GHOST = 1, BACKWARD_GHOST = 5 };
+    int region; // BODY, FORWARD_GHOST + dim or BACKWARD_GHOST + dim
+    int index;  // checkerboard index of the site within that region
+  };
+
+  /**
+     @brief Return the neighbour table of the present local lattice
+     (as set by setDims), built on first use and cached thereafter, so
+     that reference operators need not recompute neighbour indices
+     for every site.  Must not be called from within a parallel
+     region.
+     @param[in] distance Hop distance
+     @param[in] nFace Depth of the ghost zone
+     @param[in] ghost Whether hops that leave a partitioned dimension
+     index the ghost zone (as in the _mg4dir functions) rather than
+     wrapping around the local lattice
+     @param[in] Ls Extent of the fifth dimension of the ghost zone,
+     whose layers are ordered as (layer, s, face site); the ghost index
+     returned is that of s = 0
+     @return Table indexed as [(parity * 8 + dir) * Vh + i], where dir
+     = 0..7 corresponds to +x, -x, +y, -y, +z, -z, +t, -t
+   */
+  const LatticeNeighbor *neighborTable(int distance, int nFace, bool ghost, int Ls = 1);
+
+  /**
+     @brief Coordinates and full-lattice indices of every site of a
+     checkerboarded local lattice, computed once per geometry.  The
+     index helpers (fullLatticeIndex, neighborIndex and their
+     variants) reduce to lookups into these tables followed by a
+     conditional wrap.  The 5-d lattice (in both 5-d and 4-d
+     preconditioned orderings) maps each site onto an entry of the
+     4-d tables, since a 5-d site only differs from its 4-d site by
+     the offset of its s-slice and, in the 5-d ordering, by the
+     parity of s.
+   */
+  class LatticeGeometry {
+    int X[4];
+    int Ls;
+    int volumeCB;
+    std::vector<int> x4d;    // x[0..3] of each site, indexed by parity * volumeCB + i
+    std::vector<int> idx4d;  // full lattice index of each site
+    std::vector<int> site5d; // 4-d table entry of each 5-d site, indexed by (type * 2 + parity) * Ls * volumeCB + i
+    std::vector<int> s5d;    // s-slice of each 5-d checkerboard index i
+
+    /** 4-d table entry of 5-d checkerboard site i */
+    int site(int i, int parity, QudaDWFPCType type) const {
+      return site5d[((type == QUDA_5D_PC ? 0 : 1) * 2 + parity) * Ls * volumeCB + i];
+    }
+
+  public:
+    LatticeGeometry(const int dim[4], int Ls);
+
+    /** Whether this geometry describes the lattice dim (with fifth dimension Ls, unless Ls = 0) */
+    bool matches(const int dim[4], int Ls) const {
+      return X[0] == dim[0] && X[1] == dim[1] && X[2] == dim[2] && X[3] == dim[3] && (Ls == 0 || this->Ls == Ls);
+    }
+
+    int VolumeCB() const { return volumeCB; }
+
+    /** Coordinates x[0..3] of checkerboard site i of the given parity */
+    const int *coords(int i, int parity) const { return &x4d[(parity * volumeCB + i) * 4]; }
+
+    /** Full lattice index of checkerboard site i of the given parity */
+    int fullIndex(int i, int parity) const { return idx4d[parity * volumeCB + i]; }
+
+    /** Coordinates x[0..4] (x[4] is the fifth dimension) of 5-d checkerboard site i */
+    void coords5d(int x[5], int i, int parity, QudaDWFPCType type) const {
+      const int *y = &x4d[site(i, parity, type) * 4];
+      for (int d = 0; d < 4; d++) x[d] = y[d];
+      x[4] = s5d[i];
+    }
+
+    /** Full 5-d lattice index of 5-d checkerboard site i */
+    int fullIndex5d(int i, int parity, QudaDWFPCType type) const {
+      return 2 * s5d[i] * volumeCB + idx4d[site(i, parity, type)];
+    }
+
+    /** Checkerboard index of the site with coordinates x, which must lie in the lattice */
+    int index(const int x[4]) const { return (((x[3] * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0]) >> 1; }
+
+    /** Wrap a displaced coordinate back into [0, L) */
+    static int wrap(int x, int L) {
+      while (x < 0) x += L;
+      while (x >= L) x -= L;
+      return x;
+    }
+
+    /** Checkerboard index of the site displaced by dx[0..3] (periodic) from site i */
+    int neighbor(int i, int parity, const int dx[4]) const {
+      const int *x = coords(i, parity);
+      const int y[4] = {wrap(x[0] + dx[0], X[0]), wrap(x[1] + dx[1], X[1]), wrap(x[2] + dx[2], X[2]), wrap(x[3] + dx[3], X[3])};
+      return index(y);
+    }
+  };
+
+  /**
+     @brief Return the geometry of a local lattice, built on first use
+     and shared by all reference operators thereafter.  May be called
+     from within a parallel region.
+     @param[in] dim Local lattice dimensions
+     @param[in] Ls Extent of the fifth dimension, or 0 if only the
+     4-d tables are needed
+   */
+  const LatticeGeometry &latticeGeometry(const int dim[4], int Ls = 0);
+
   void printSpinorElement(void *spinor, int X, QudaPrecision precision);
   void printGaugeElement(void *gauge, int X, QudaPrecision precision);
   
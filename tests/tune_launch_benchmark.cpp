@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include <quda.h>
+#include <quda_internal.h>
+#include <tune_quda.h>
+
+#include <test_util.h>
+#include <misc.h>
+
+/**
+   Measure the host overhead of tuneLaunch() for a kernel whose
+   parameters are already cached.  The tunecache is first filled with
+   a number of trivial entries, after which one of them is launched
+   repeatedly, both from a single Tunable and, as most of QUDA's
+   kernels are launched, from a Tunable constructed for each launch.
+   Only the public tuneLaunch() interface is used, so that the same
+   benchmark can be built against an earlier version of QUDA for
+   comparison.  Build QUDA with LAUNCH_TIMER defined in lib/tune.cpp
+   for a breakdown of the time spent in tuneLaunch(), which is printed
+   by endQuda().
+
+   QUDA_RESOURCE_PATH is ignored so that the benchmark entries do not
+   end up in the on-disk tunecache.
+
+   usage: tune_launch_benchmark [--entries N] [--launches N]
+ */
+
+extern int device;
+extern int gridsize_from_cmdline[];
+extern QudaVerbosity verbosity;
+
+using namespace quda;
+
+static int n_entries = 1024;
+static int n_launches = 1000000;
+
+static void usage(char **argv)
+{
+  printf("usage: %s [--entries N] [--launches N]\n", argv[0]);
+  printf("       --entries N      Number of entries to fill the tunecache with (default %d)\n", n_entries);
+  printf("       --launches N     Number of timed launches (default %d)\n", n_launches);
+  exit(1);
+}
+
+/**
+   A kernel that does nothing, with a single launch configuration so
+   that tuning it is immediate
+ */
+class LaunchBenchmark : public Tunable {
+  const char *vol;
+
+  long long flops() const { return 0; }
+  unsigned int sharedBytesPerThread() const { return 0; }
+  unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+
+public:
+  LaunchBenchmark(int id)
+  {
+    static const char *volumes[] = {"4x4x4x4", "8x8x8x8", "16x16x16x16", "24x24x24x48"};
+    vol = volumes[id % 4];
+    writeAuxString("benchmark,id=%d", id);
+  }
+
+  bool advanceTuneParam(TuneParam &param) const { return false; }
+  TuneKey tuneKey() const { return TuneKey(vol, typeid(*this).name(), aux); }
+  void apply(const cudaStream_t &stream) { tuneLaunch(*this, getTuning(), getVerbosity()); }
+};
+
+template <typename Op> static double timeLaunches(Op op)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_launches; i++) op();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / n_launches;
+}
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++) {
+    if (process_command_line_option(argc, argv, &i) == 0) continue;
+    if (strcmp(argv[i], "--entries") == 0 && i + 1 < argc) {
+      n_entries = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--launches") == 0 && i + 1 < argc) {
+      n_launches = atoi(argv[++i]);
+    } else {
+      usage(argv);
+    }
+  }
+  if (n_entries <= 0 || n_launches <= 0) usage(argv);
+
+  unsetenv("QUDA_RESOURCE_PATH");
+  initComms(argc, argv, gridsize_from_cmdline);
+  initQuda(device);
+  setVerbosity(verbosity);
+
+  // fill the tunecache
+  for (int i = 0; i < n_entries; i++) {
+    LaunchBenchmark kernel(i);
+    kernel.apply(0);
+  }
+  printfQuda("Added %d entries to the tunecache, timing %d launches of each variant\n", n_entries, n_launches);
+
+  const int id = n_entries / 2;
+  LaunchBenchmark kernel(id);
+
+  double persistent_ns = timeLaunches([&]() { tuneLaunch(kernel, QUDA_TUNE_YES, QUDA_SUMMARIZE); });
+  double transient_ns = timeLaunches([&]() {
+    LaunchBenchmark transient(id);
+    tuneLaunch(transient, QUDA_TUNE_YES, QUDA_SUMMARIZE);
+  });
+
+  printfQuda("tuneLaunch(), persistent tunable       : %8.1f ns per launch\n", persistent_ns);
+  printfQuda("tuneLaunch(), tunable built per launch : %8.1f ns per launch\n", transient_ns);
+
+  endQuda();
+  finalizeComms();
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tune_quda.h>
+#include <test_util.h>
+
+/**
+   Convert between the binary tunecache (tunecache.bin) and the
+   human-readable TSV tunecache (tunecache.tsv).
+
+   usage: tunecache_convert --export tunecache.bin tunecache.tsv
+          tunecache_convert --import tunecache.tsv tunecache.bin
+ */
+
+static void usage(char **argv)
+{
+  printf("usage: %s --export <binary cache> <tsv cache>\n", argv[0]);
+  printf("       %s --import <tsv cache> <binary cache>\n", argv[0]);
+  exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 4) usage(argv);
+
+  const int commDims[4] = {1, 1, 1, 1};
+  initComms(argc, argv, commDims);
+
+  if (strcmp(argv[1], "--export") == 0) {
+    quda::exportTuneCache(argv[2], argv[3]);
+  } else if (strcmp(argv[1], "--import") == 0) {
+    quda::importTuneCache(argv[2], argv[3]);
+  } else {
+    usage(argv);
+  }
+
+  finalizeComms();
+  return 0;
+}
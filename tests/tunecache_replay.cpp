@@ -0,0 +1,537 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cxxabi.h>
+
+#include <quda.h>
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <blas_quda.h>
+#include <multigrid.h>
+#include <transfer.h>
+#include <timer.h>
+#include <tune_quda.h>
+
+#include <test_util.h>
+#include <misc.h>
+
+/**
+   Offline replay of a tunecache.  The entries of the given cache
+   (binary or TSV) are parsed, and the CPU-runnable kernel families
+   among them (coarse dslash, restrictor / prolongator, spinor copies
+   and the common blas / reduction kernels) are rebuilt on host
+   fields of the recorded geometry and precision, launched once and
+   then timed over a number of iterations.  Of these only the coarse
+   dslash is autotuned on the host, so it is the only family that is
+   tuned if it is not yet present in the live cache; the others are
+   only re-timed.  A report with the recorded and replayed launch
+   parameters and times is written, and on exit the live cache is
+   saved to QUDA_RESOURCE_PATH as usual.
+
+   Point QUDA_RESOURCE_PATH at an empty directory to re-tune every
+   replayed host coarse dslash from scratch, or at the directory
+   holding the cache to re-time the recorded launch parameters.
+   Recorded and replayed times are only compared for entries that
+   were recorded on the host; device entries are reported with their
+   replayed host time alone.
+
+   usage: tunecache_replay [--niter N] [--report file] <tunecache.bin|tunecache.tsv>
+ */
+
+extern int device;
+extern int gridsize_from_cmdline[];
+extern QudaVerbosity verbosity;
+
+namespace quda {
+  typedef std::map<TuneKey, TuneParam> map;
+  map getTuneCache();
+}
+
+using namespace quda;
+
+static int replay_iter = 100;
+static std::string report_file = "tunecache_replay.tsv";
+
+static void usage(char **argv)
+{
+  printf("usage: %s [--niter N] [--report file] <tunecache>\n", argv[0]);
+  printf("       --niter N        Number of timed iterations per entry (default %d)\n", replay_iter);
+  printf("       --report file    Performance report to write (default %s)\n", report_file.c_str());
+  exit(1);
+}
+
+/**
+   Description of a field as recorded in a volume string and a
+   ColorSpinorField::AuxString()
+ */
+struct FieldDesc {
+  int nDim;
+  int x[QUDA_MAX_DIM];
+  QudaPrecision precision;
+  int nSpin;
+  int nColor;
+  QudaSiteSubset siteSubset;
+};
+
+/**
+   Parse a volume string of the form "AxBxCxD[xE]", stopping at the
+   first comma.  Returns the number of dimensions parsed.
+ */
+static int parseVolume(const char *vol, int *x)
+{
+  int nDim = 0;
+  while (*vol && nDim < QUDA_MAX_DIM) {
+    char *end;
+    x[nDim++] = strtol(vol, &end, 10);
+    if (end == vol || (*end != 'x')) break;
+    vol = end + 1;
+  }
+  return nDim;
+}
+
+/**
+   Parse a field description from its volume string and the aux
+   string at (or after) the given position.
+ */
+static bool parseField(const char *vol, const char *aux, FieldDesc &f)
+{
+  aux = strstr(aux, "vol=");
+  if (!aux) return false;
+  int volume, stride, precision;
+  if (sscanf(aux, "vol=%d,stride=%d,precision=%d,Ns=%d,Nc=%d", &volume, &stride, &precision, &f.nSpin, &f.nColor) != 5)
+    return false;
+  f.nDim = parseVolume(vol, f.x);
+  if (f.nDim < 4) return false;
+  f.siteSubset = stride >= volume ? QUDA_PARITY_SITE_SUBSET : QUDA_FULL_SITE_SUBSET;
+  f.precision = static_cast<QudaPrecision>(precision);
+  return f.precision == QUDA_DOUBLE_PRECISION || f.precision == QUDA_SINGLE_PRECISION ||
+    f.precision == QUDA_HALF_PRECISION || f.precision == QUDA_QUARTER_PRECISION;
+}
+
+static QudaPrecision precisionFromType(const std::string &type)
+{
+  if (type == "double") return QUDA_DOUBLE_PRECISION;
+  if (type == "float") return QUDA_SINGLE_PRECISION;
+  if (type == "short") return QUDA_HALF_PRECISION;
+  if (type == "char" || type == "signed char") return QUDA_QUARTER_PRECISION;
+  return QUDA_INVALID_PRECISION;
+}
+
+static std::string demangle(const char *name)
+{
+  int status;
+  char *demangled = abi::__cxa_demangle(name, 0, 0, &status);
+  std::string str(status == 0 ? demangled : name);
+  free(demangled);
+  return str;
+}
+
+/**
+   Return the unqualified class name of a demangled type name, e.g.,
+   "quda::blas::axpbyz_<float2, float4>" returns "axpbyz_"
+ */
+static std::string className(const std::string &name)
+{
+  std::string base = name.substr(0, name.find('<'));
+  size_t pos = base.rfind("::");
+  return pos == std::string::npos ? base : base.substr(pos + 2);
+}
+
+static cpuColorSpinorField *createField(const FieldDesc &f)
+{
+  ColorSpinorParam param;
+  param.nColor = f.nColor;
+  param.nSpin = f.nSpin;
+  param.nDim = f.nDim;
+  for (int d = 0; d < f.nDim; d++) param.x[d] = f.x[d];
+  param.pad = 0; // padding must be zero for cpu fields
+  param.siteSubset = f.siteSubset;
+  param.PCtype = QUDA_4D_PC;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = f.nSpin == 4 ? QUDA_UKQCD_GAMMA_BASIS : QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+
+  // half and quarter host fields are block-float, so the random source is set through single precision
+  const bool fixed = f.precision == QUDA_HALF_PRECISION || f.precision == QUDA_QUARTER_PRECISION;
+  param.setPrecision(fixed ? QUDA_SINGLE_PRECISION : f.precision);
+  cpuColorSpinorField *field = new cpuColorSpinorField(param);
+  field->Source(QUDA_RANDOM_SOURCE);
+
+  if (fixed) {
+    param.setPrecision(f.precision);
+    cpuColorSpinorField *field_fixed = new cpuColorSpinorField(param);
+    *field_fixed = *field;
+    delete field;
+    field = field_fixed;
+  }
+  return field;
+}
+
+/**
+   A single replayed entry: the kernel family, the recorded key,
+   parameters and the location they were tuned at, the key that was
+   launched when replaying (if the family is autotuned on the host)
+   and the measured time per call.
+ */
+struct ReplayResult {
+  std::string family;
+  TuneKey key;
+  TuneParam recorded;
+  QudaFieldLocation location;
+  bool tuned;
+  TuneKey replay_key;
+  double secs;
+};
+
+/**
+   Launch the given operation once, so that it is tuned if needed,
+   and then time it over replay_iter iterations.
+ */
+template <typename Op> static void timeReplay(ReplayResult &result, Op op)
+{
+  TuneKey last = getLastTuneKey();
+  op();
+  TuneKey launched = getLastTuneKey();
+  result.tuned = strcmp(last.name, launched.name) || strcmp(last.volume, launched.volume) || strcmp(last.aux, launched.aux);
+  result.replay_key = launched;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < replay_iter; i++) op();
+  auto stop = std::chrono::steady_clock::now();
+  result.secs = std::chrono::duration<double>(stop - start).count() / replay_iter;
+}
+
+/**
+   Replay a coarse dslash from its policy key, whose aux string is
+   "policy,[dslash][clover],<inA aux>,gauge_prec=..,halo_prec=..,..."
+ */
+static bool replayCoarseDslash(const TuneKey &key, ReplayResult &result)
+{
+  if (strncmp(key.aux, "policy,", 7)) return false; // kernel keys are covered by their policy
+  const char *aux = key.aux + 7;
+  bool dslash = !strncmp(aux, "dslash", 6);
+  if (dslash) aux += 6;
+  bool clover = !strncmp(aux, "clover", 6);
+
+  FieldDesc f;
+  if (!parseField(key.volume, aux, f) || f.nSpin != 2) return false;
+
+  int gauge_prec, halo_prec;
+  const char *prec_aux = strstr(aux, ",gauge_prec=");
+  if (!prec_aux || sscanf(prec_aux, ",gauge_prec=%d,halo_prec=%d", &gauge_prec, &halo_prec) != 2) return false;
+  // there are no host quarter-precision links, and no host halo packer for block-float spinors
+  if (gauge_prec == QUDA_QUARTER_PRECISION) return false;
+  if (comm_partitioned() && f.precision < QUDA_SINGLE_PRECISION) return false;
+
+  cpuColorSpinorField *out = createField(f);
+  cpuColorSpinorField *inA = createField(f);
+  cpuColorSpinorField *inB = createField(f);
+
+  GaugeFieldParam gParam;
+  for (int d = 0; d < 4; d++) gParam.x[d] = f.x[d];
+  if (f.siteSubset == QUDA_PARITY_SITE_SUBSET) gParam.x[0] *= 2;
+  gParam.nColor = f.nColor * f.nSpin;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.link_type = QUDA_COARSE_LINKS;
+  gParam.t_boundary = QUDA_PERIODIC_T;
+  gParam.create = QUDA_ZERO_FIELD_CREATE;
+  gParam.setPrecision(static_cast<QudaPrecision>(gauge_prec));
+  gParam.nDim = 4;
+  gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  gParam.nFace = 1;
+  gParam.geometry = QUDA_COARSE_GEOMETRY;
+  cpuGaugeField Y(gParam);
+
+  gParam.geometry = QUDA_SCALAR_GEOMETRY;
+  gParam.nFace = 0;
+  cpuGaugeField X(gParam);
+
+  int commDim[4];
+  for (int d = 0; d < 4; d++) commDim[d] = comm_dim_partitioned(d);
+  const int parity = f.siteSubset == QUDA_PARITY_SITE_SUBSET ? QUDA_EVEN_PARITY : QUDA_INVALID_PARITY;
+  const double kappa = 0.1;
+
+  timeReplay(result, [&]() {
+    ApplyCoarse(*out, *inA, *inB, Y, X, kappa, parity, dslash, clover, false, commDim,
+                static_cast<QudaPrecision>(halo_prec));
+  });
+
+  delete inB;
+  delete inA;
+  delete out;
+  return true;
+}
+
+/**
+   Replay a restrictor or prolongator through a host Transfer built
+   from random null-space vectors.  Restrictor keys have volume
+   "coarse,fine" and aux "<location>,<coarse aux>,<fine aux>", while
+   prolongator keys have volume "fine,coarse" and aux "<fine
+   aux>,<coarse aux>".
+ */
+static bool replayTransfer(const TuneKey &key, bool restrict, ReplayResult &result)
+{
+  const char *vol_split = strchr(key.volume, ',');
+  const char *aux_first = strstr(key.aux, "vol=");
+  const char *aux_second = aux_first ? strstr(aux_first + 4, "vol=") : nullptr;
+  if (!vol_split || !aux_second) return false;
+
+  FieldDesc fine, coarse;
+  if (restrict) {
+    if (!parseField(key.volume, aux_first, coarse) || !parseField(vol_split + 1, aux_second, fine)) return false;
+  } else {
+    if (!parseField(key.volume, aux_first, fine) || !parseField(vol_split + 1, aux_second, coarse)) return false;
+  }
+  if (fine.nDim != coarse.nDim || coarse.nSpin == 0 || fine.nSpin % coarse.nSpin) return false;
+  // the transfer operators are only instantiated for double and single precision spinors
+  if (fine.precision < QUDA_SINGLE_PRECISION) return false;
+
+  int geo_bs[QUDA_MAX_DIM];
+  for (int d = 0; d < fine.nDim; d++) {
+    if (coarse.x[d] == 0 || fine.x[d] % coarse.x[d]) return false;
+    geo_bs[d] = fine.x[d] / coarse.x[d];
+  }
+  // the transfer operator is always constructed on full fields
+  fine.siteSubset = QUDA_FULL_SITE_SUBSET;
+  coarse.siteSubset = QUDA_FULL_SITE_SUBSET;
+  coarse.precision = fine.precision;
+
+  std::vector<ColorSpinorField *> B(coarse.nColor);
+  for (auto &b : B) b = createField(fine);
+
+  static TimeProfile profile("tunecache_replay");
+  Transfer transfer(B, coarse.nColor, geo_bs, fine.nSpin / coarse.nSpin, fine.precision, profile);
+  transfer.setTransferGPU(false);
+
+  cpuColorSpinorField *fine_field = createField(fine);
+  cpuColorSpinorField *coarse_field = createField(coarse);
+
+  if (restrict) timeReplay(result, [&]() { transfer.R(*coarse_field, *fine_field); });
+  else timeReplay(result, [&]() { transfer.P(*fine_field, *coarse_field); });
+
+  delete coarse_field;
+  delete fine_field;
+  for (auto &b : B) delete b;
+  return true;
+}
+
+/**
+   Replay a spinor copy.  copyKernel keys have aux
+   "dst=<aux>,src=<aux>", while CopyColorSpinor carries the output and
+   input precisions, spin and color in its template signature.
+ */
+static bool replayCopy(const TuneKey &key, const std::string &name, ReplayResult &result)
+{
+  FieldDesc dst, src;
+  if (!strcmp(key.name, "copyKernel")) {
+    const char *src_aux = strstr(key.aux, ",src=");
+    if (!src_aux || !parseField(key.volume, key.aux, dst) || !parseField(key.volume, src_aux, src)) return false;
+  } else {
+    // quda::CopyColorSpinor<FloatOut, FloatIn, Ns, Nc, Arg>
+    size_t begin = name.find('<');
+    if (begin == std::string::npos) return false;
+    std::vector<std::string> args;
+    std::string args_str = name.substr(begin + 1);
+    for (size_t pos = 0; args.size() < 4;) {
+      size_t end = args_str.find(',', pos);
+      if (end == std::string::npos) return false;
+      args.push_back(args_str.substr(pos, end - pos));
+      pos = args_str.find_first_not_of(' ', end + 1);
+    }
+    int out_stride, in_stride;
+    if (sscanf(key.aux, "out_stride=%d,in_stride=%d", &out_stride, &in_stride) != 2) return false;
+    dst.nDim = parseVolume(key.volume, dst.x);
+    if (dst.nDim < 4) return false;
+    int volume = 1;
+    for (int d = 0; d < dst.nDim; d++) volume *= dst.x[d];
+    dst.siteSubset = in_stride >= volume ? QUDA_PARITY_SITE_SUBSET : QUDA_FULL_SITE_SUBSET;
+    dst.nSpin = atoi(args[2].c_str());
+    dst.nColor = atoi(args[3].c_str());
+    src = dst;
+    dst.precision = precisionFromType(args[0]);
+    src.precision = precisionFromType(args[1]);
+    if (dst.precision == QUDA_INVALID_PRECISION || src.precision == QUDA_INVALID_PRECISION) return false;
+  }
+
+  cpuColorSpinorField *dst_field = createField(dst);
+  cpuColorSpinorField *src_field = createField(src);
+  timeReplay(result, [&]() { *dst_field = *src_field; });
+  delete src_field;
+  delete dst_field;
+  return true;
+}
+
+/**
+   Replay one of the common blas and reduction kernels.  The key aux
+   is the AuxString of x, followed by that of y for mixed-precision
+   kernels; the kernels are replayed uniformly in the precision of x.
+ */
+static bool replayBlas(const TuneKey &key, const std::string &name, ReplayResult &result)
+{
+  const std::string kernel = className(name);
+  FieldDesc f;
+  if (!parseField(key.volume, key.aux, f)) return false;
+
+  cpuColorSpinorField *x = createField(f);
+  cpuColorSpinorField *y = createField(f);
+  cpuColorSpinorField *z = createField(f);
+  const Complex a(0.5, 0.1), b(0.3, -0.2);
+  bool known = true;
+
+  if (kernel == "axpbyz_") timeReplay(result, [&]() { blas::axpbyz(0.5, *x, 0.3, *y, *z); });
+  else if (kernel == "ax_") timeReplay(result, [&]() { blas::ax(1.0, *x); });
+  else if (kernel == "caxpy_") timeReplay(result, [&]() { blas::caxpy(a, *x, *y); });
+  else if (kernel == "caxpby_") timeReplay(result, [&]() { blas::caxpby(a, *x, b, *y); });
+  else if (kernel == "Norm2") timeReplay(result, [&]() { blas::norm2(*x); });
+  else if (kernel == "Dot") timeReplay(result, [&]() { blas::reDotProduct(*x, *y); });
+  else if (kernel == "Cdot") timeReplay(result, [&]() { blas::cDotProduct(*x, *y); });
+  else known = false;
+
+  delete z;
+  delete y;
+  delete x;
+  return known;
+}
+
+/**
+   Return the location at which a recorded entry was tuned.  The
+   coarse dslash policy key does not carry a location, so it is taken
+   from the policy kernel entries recorded for the same field, whose
+   aux string starts with "policy_kernel,CPU," when run on the host.
+   The other replayed families are only autotuned on the device.
+ */
+static QudaFieldLocation recordedLocation(const ReplayResult &result, const map &recorded)
+{
+  if (result.family != "dslash_coarse") return QUDA_CUDA_FIELD_LOCATION;
+
+  const char *field_aux = strstr(result.key.aux, "vol=");
+  const char *field_end = field_aux ? strstr(field_aux, ",gauge_prec=") : nullptr;
+  if (!field_end) return QUDA_CUDA_FIELD_LOCATION;
+  const std::string field(field_aux, field_end - field_aux);
+  const std::string host_prefix = "policy_kernel,CPU," + field;
+
+  for (auto &entry : recorded) {
+    const TuneKey &key = entry.first;
+    if (!strcmp(key.volume, result.key.volume) && !strncmp(key.aux, host_prefix.c_str(), host_prefix.size()))
+      return QUDA_CPU_FIELD_LOCATION;
+  }
+  return QUDA_CUDA_FIELD_LOCATION;
+}
+
+static void writeReport(const std::vector<ReplayResult> &results)
+{
+  std::ofstream out(report_file.c_str());
+  if (!out) errorQuda("Unable to open %s", report_file.c_str());
+  out << "family\tvolume\tname\taux\trecorded_location\trecorded_time\treplay_time\tspeedup\trecorded_param\treplay_param"
+      << std::endl;
+  const map &cache = getTuneCache();
+  for (auto &r : results) {
+    std::stringstream recorded, replayed, speedup;
+    recorded << r.recorded;
+    auto it = cache.find(r.replay_key);
+    if (r.tuned && it != cache.end()) replayed << it->second;
+    else replayed << "untuned";
+    // replays are run on the host, so only host-tuned entries can be compared against their recorded time
+    if (r.location == QUDA_CPU_FIELD_LOCATION && r.secs > 0.0 && r.recorded.time < FLT_MAX)
+      speedup << r.recorded.time / r.secs;
+    else
+      speedup << "-";
+    out << r.family << "\t" << r.key.volume << "\t" << r.key.name << "\t" << r.key.aux << "\t"
+        << (r.location == QUDA_CPU_FIELD_LOCATION ? "host" : "device") << "\t" << r.recorded.time << "\t" << r.secs
+        << "\t" << speedup.str() << "\t" << recorded.str() << "\t" << replayed.str() << std::endl;
+  }
+  out.close();
+  printfQuda("Wrote replay report for %lu entries to %s\n", results.size(), report_file.c_str());
+}
+
+int main(int argc, char **argv)
+{
+  const char *cache_path = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (process_command_line_option(argc, argv, &i) == 0) continue;
+    if (strcmp(argv[i], "--niter") == 0 && i + 1 < argc) {
+      replay_iter = atoi(argv[++i]);
+      if (replay_iter <= 0) usage(argv);
+    } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+      report_file = argv[++i];
+    } else if (!cache_path && argv[i][0] != '-') {
+      cache_path = argv[i];
+    } else {
+      usage(argv);
+    }
+  }
+  if (!cache_path) usage(argv);
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  initQuda(device);
+  setVerbosity(verbosity);
+
+  map recorded;
+  readTuneCache(cache_path, recorded);
+
+  std::vector<ReplayResult> results;
+  std::map<std::string, int> skipped;
+
+  for (auto &entry : recorded) {
+    const TuneKey &key = entry.first;
+    const std::string name = demangle(key.name);
+    const std::string kernel = className(name);
+
+    ReplayResult result;
+    result.key = key;
+    result.recorded = entry.second;
+    result.location = QUDA_CUDA_FIELD_LOCATION;
+    result.tuned = false;
+    result.secs = 0.0;
+
+    bool replayed = false;
+    if (kernel == "DslashCoarsePolicyTune") {
+      result.family = "dslash_coarse";
+      replayed = replayCoarseDslash(key, result);
+    } else if (kernel == "RestrictLaunch") {
+      result.family = "restrict";
+      replayed = replayTransfer(key, true, result);
+    } else if (kernel == "ProlongateLaunch") {
+      result.family = "prolongate";
+      replayed = replayTransfer(key, false, result);
+    } else if (kernel == "copyKernel" || kernel == "CopyColorSpinor") {
+      result.family = "copy";
+      replayed = replayCopy(key, name, result);
+    } else if (name.find("quda::blas::") == 0) {
+      result.family = "blas";
+      replayed = replayBlas(key, name, result);
+    }
+
+    if (replayed) {
+      result.location = recordedLocation(result, recorded);
+      results.push_back(result);
+      if (getVerbosity() >= QUDA_VERBOSE)
+        printfQuda("Replayed %s %s %s: %e s recorded on the %s, %e s replayed\n", result.family.c_str(), key.volume,
+                   kernel.c_str(), result.recorded.time,
+                   result.location == QUDA_CPU_FIELD_LOCATION ? "host" : "device", result.secs);
+    } else {
+      skipped[kernel]++;
+    }
+  }
+
+  printfQuda("Replayed %lu of %lu tunecache entries from %s\n", results.size(), recorded.size(), cache_path);
+  if (getVerbosity() >= QUDA_SUMMARIZE)
+    for (auto &s : skipped) printfQuda("  skipped %4d entries of %s\n", s.second, s.first.c_str());
+
+  writeReport(results);
+
+  endQuda(); // saves the live tunecache to QUDA_RESOURCE_PATH
+  finalizeComms();
+  return 0;
+}
@@ -99,87 +99,60 @@ void multiplySpinorByDiracProjector(Float *res, int projIdx, Float *spinorIn) {
 // if daggerBit is zero: perform ordinary dslash operator
 // if daggerBit is one:  perform hermitian conjugate of dslash
 //
-
-#ifndef MULTI_GPU
-
+// The neighbours are taken from the precomputed neighborTable, so the
+// sites are independent and are distributed over threads.  Without
+// MULTI_GPU the ghost arguments are unused and all hops wrap around
+// the local lattice.
+//
 template <typename sFloat, typename gFloat>
-void dslashReference(sFloat *res, gFloat **gaugeFull, sFloat *spinorField, int oddBit, int daggerBit) {
-  for (int i=0; i<Vh*mySpinorSiteSize; i++) res[i] = 0.0;
-  
-  gFloat *gaugeEven[4], *gaugeOdd[4];
-  for (int dir = 0; dir < 4; dir++) {  
-    gaugeEven[dir] = gaugeFull[dir];
-    gaugeOdd[dir]  = gaugeFull[dir]+Vh*gaugeSiteSize;
-  }
-  
-  for (int i = 0; i < Vh; i++) {
-    for (int dir = 0; dir < 8; dir++) {
-      gFloat *gauge = gaugeLink(i, dir, oddBit, gaugeEven, gaugeOdd, 1);
-      sFloat *spinor = spinorNeighbor(i, dir, oddBit, spinorField, 1);
-      
-      sFloat projectedSpinor[4*3*2], gaugedSpinor[4*3*2];
-      int projIdx = 2*(dir/2)+(dir+daggerBit)%2;
-      multiplySpinorByDiracProjector(projectedSpinor, projIdx, spinor);
-      
-      for (int s = 0; s < 4; s++) {
-	if (dir % 2 == 0) su3Mul(&gaugedSpinor[s*(3*2)], gauge, &projectedSpinor[s*(3*2)]);
-	else su3Tmul(&gaugedSpinor[s*(3*2)], gauge, &projectedSpinor[s*(3*2)]);
-      }
-      
-      sum(&res[i*(4*3*2)], &res[i*(4*3*2)], gaugedSpinor, 4*3*2);
-    }
-  }
-}
-
+void dslashReference(sFloat *res, gFloat **gaugeFull, gFloat **ghostGauge, sFloat *spinorField,
+		     sFloat **fwdSpinor, sFloat **backSpinor, int oddBit, int daggerBit) {
+#ifdef MULTI_GPU
+  const bool ghost = true;
 #else
+  const bool ghost = false;
+#endif
+  const LatticeNeighbor *nbr = neighborTable(1, 1, ghost) + oddBit * 8 * Vh;
 
-template <typename sFloat, typename gFloat>
-void dslashReference(sFloat *res, gFloat **gaugeFull,  gFloat **ghostGauge, sFloat *spinorField, 
-		     sFloat **fwdSpinor, sFloat **backSpinor, int oddBit, int daggerBit) {
-  for (int i=0; i<Vh*mySpinorSiteSize; i++) res[i] = 0.0;
-  
-  gFloat *gaugeEven[4], *gaugeOdd[4];
-  gFloat *ghostGaugeEven[4], *ghostGaugeOdd[4];
-  for (int dir = 0; dir < 4; dir++) {  
-    gaugeEven[dir] = gaugeFull[dir];
-    gaugeOdd[dir]  = gaugeFull[dir]+Vh*gaugeSiteSize;
-
-    ghostGaugeEven[dir] = ghostGauge[dir];
-    ghostGaugeOdd[dir] = ghostGauge[dir] + (faceVolume[dir]/2)*gaugeSiteSize;
-  }
-  
+#pragma omp parallel for
   for (int i = 0; i < Vh; i++) {
+    sFloat *out = &res[i*mySpinorSiteSize];
+    for (int j = 0; j < mySpinorSiteSize; j++) out[j] = 0.0;
 
     for (int dir = 0; dir < 8; dir++) {
-      gFloat *gauge = gaugeLink_mg4dir(i, dir, oddBit, gaugeEven, gaugeOdd, ghostGaugeEven, ghostGaugeOdd, 1, 1);
-      sFloat *spinor = spinorNeighbor_mg4dir(i, dir, oddBit, spinorField, fwdSpinor, backSpinor, 1, 1);
-      
-      sFloat projectedSpinor[mySpinorSiteSize], gaugedSpinor[mySpinorSiteSize];
+      const LatticeNeighbor &n = nbr[dir*Vh + i];
+      const int d = dir/2;
+
+      // forward links live on this site, backward links on the neighbour (of the other parity)
+      gFloat *gauge;
+      if (dir % 2 == 0) gauge = &gaugeFull[d][(oddBit*Vh + i)*gaugeSiteSize];
+      else if (n.region == LatticeNeighbor::BODY) gauge = &gaugeFull[d][((1-oddBit)*Vh + n.index)*gaugeSiteSize];
+      else gauge = &ghostGauge[d][((1-oddBit)*(faceVolume[d]/2) + n.index)*gaugeSiteSize];
+      sFloat *spinor = neighborSite(n, spinorField, fwdSpinor, backSpinor, mySpinorSiteSize);
+
+      sFloat projectedSpinor[4*3*2], gaugedSpinor[4*3*2];
       int projIdx = 2*(dir/2)+(dir+daggerBit)%2;
       multiplySpinorByDiracProjector(projectedSpinor, projIdx, spinor);
-      
+
       for (int s = 0; s < 4; s++) {
 	if (dir % 2 == 0) su3Mul(&gaugedSpinor[s*(3*2)], gauge, &projectedSpinor[s*(3*2)]);
 	else su3Tmul(&gaugedSpinor[s*(3*2)], gauge, &projectedSpinor[s*(3*2)]);
       }
-      
-      sum(&res[i*(4*3*2)], &res[i*(4*3*2)], gaugedSpinor, 4*3*2);
-    }
 
+      sum(out, out, gaugedSpinor, 4*3*2);
+    }
   }
 }
 
-#endif
-
 // this actually applies the preconditioned dslash, e.g., D_ee^{-1} D_eo or D_oo^{-1} D_oe
 void wil_dslash(void *out, void **gauge, void *in, int oddBit, int daggerBit,
 		QudaPrecision precision, QudaGaugeParam &gauge_param) {
   
 #ifndef MULTI_GPU  
   if (precision == QUDA_DOUBLE_PRECISION)
-    dslashReference((double*)out, (double**)gauge, (double*)in, oddBit, daggerBit);
+    dslashReference((double*)out, (double**)gauge, (double**)nullptr, (double*)in, (double**)nullptr, (double**)nullptr, oddBit, daggerBit);
   else
-    dslashReference((float*)out, (float**)gauge, (float*)in, oddBit, daggerBit);
+    dslashReference((float*)out, (float**)gauge, (float**)nullptr, (float*)in, (float**)nullptr, (float**)nullptr, oddBit, daggerBit);
 #else
 
   GaugeFieldParam gauge_field_param(gauge, gauge_param);
@@ -249,6 +222,7 @@ void twistGamma5(sFloat *out, sFloat *in, const int dagger, const sFloat kappa,
 
   if (dagger) a *= -1.0;
 
+#pragma omp parallel for
   for(int i = 0; i < V; i++) {
     sFloat tmp[24];
     for(int s = 0; s < 4; s++)
@@ -430,6 +404,7 @@ void ndegTwistGamma5(sFloat *out1, sFloat *out2, sFloat *in1, sFloat *in2, const
 
   if (dagger) a *= -1.0;
   
+#pragma omp parallel for
   for(int i = 0; i < V; i++) {
     sFloat tmp1[24];
     sFloat tmp2[24];    